@@ -17,7 +17,7 @@
 #pragma once
 
 #include "../bc_orbiter/vessel.h"
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/rotary_display.h"
 #include "../bc_orbiter/on_off_input.h"
 #include "../bc_orbiter/status_display.h"
@@ -71,6 +71,7 @@ public:
     }
 
     double amp_draw() const override { return IsPowered() ? 5.0 : 0.0; }
+    bool reports_draw() const override { return true; }
 
     // manage_state
     bool handle_load_state(bco::vessel & vessel, const std::string & line) override {
@@ -78,6 +79,7 @@ public:
         int v;
         in >> v;
         sigSwitch_.fire((v != 0) ? true : false);
+        power_.draw_changed(this);
         return true;
     }
 
@@ -123,6 +125,7 @@ public:
     void TogglePowerSwitch()
     {
         sigSwitch_.fire(!sigSwitch_.current());
+        power_.draw_changed(this);
     }
 
 private:
@@ -0,0 +1,162 @@
+//	AeroModel - SR-71r Orbiter Addon
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// The built in aero model.  Kept free of Orbiter headers so the AeroTable tool can build the aero
+// database (SR71r_aero.csv) from it, and sweep it, outside Orbiter.  The drag functions are passed
+// in: LiftCoeff.cpp builds the tables from oapiGetInducedDrag and oapiGetWaveDrag, InducedDrag and
+// WaveDrag below only stand in for them off tree.
+
+#include "../bc_orbiter/uniform_table.h"
+
+#include <cmath>
+
+// Aerodynamics:
+											        // From NASA:
+											        // Wing span 56.60ft -> 17.25m
+												    // Mean chord 37.70ft -> 11.49m
+const double VERT_WING_AREA         = 198.2     ;   // chord * span = 198.2
+const double VERT_WING_AR           =   1.50    ;   // AR 17.25^2 / 198.2  (wingspan^2 / area)
+const double VERT_WING_CHORD        =  11.49    ;   // area / span
+const double VERT_WIND_EFFICIENCY   =   0.7     ;   // A guess.
+
+const double HORZ_WING_AREA         =  12.0     ;   // Rudders * 2
+const double HORZ_WING_AR           =   1.2     ;   // 3.8^2 (height of both rudders) / 12 (area) - treat two rudders as one big wing.
+const double HORZ_WING_CHORD        =   3.15    ;   // area / span
+const double HORZ_WING_EFFICIENCY   =   0.6     ;   // A guess.
+
+namespace aero_model {
+
+	constexpr double PI_		= 3.14159265358979323846;
+	constexpr double DEG		= PI_ / 180.0;
+
+	using InducedDragFunc	= double (*)(double cl, double A, double e);
+	using WaveDragFunc		= double (*)(double M, double M1, double M2, double M3, double cmax);
+
+	// Wave drag rise, the arguments to oapiGetWaveDrag after M.
+	constexpr double WAVE_M1	= 0.75;
+	constexpr double WAVE_M2	= 1.0;
+	constexpr double WAVE_M3	= 1.1;
+	constexpr double WAVE_CMAX	= 0.04;
+
+	// Off tree stand in for oapiGetInducedDrag, its documented formula.
+	inline double InducedDrag(double cl, double A, double e)
+	{
+		return cl * cl / (PI_ * A * e);
+	}
+
+	// Off tree stand in for oapiGetWaveDrag, its documented formula.
+	inline double WaveDrag(double M, double M1, double M2, double M3, double cmax)
+	{
+		if (M < M1) return 0.0;
+		if (M < M2) return cmax * (M - M1) / (M2 - M1);
+		if (M < M3) return cmax;
+		return cmax * sqrt((M3 * M3 - 1.0) / (M * M - 1.0));
+	}
+
+	inline double WaveDrag(double M, WaveDragFunc wave = WaveDrag)
+	{
+		return wave(M, WAVE_M1, WAVE_M2, WAVE_M3, WAVE_CMAX);
+	}
+
+	// Borrowed from DeltaGlider.  Lift, moment and profile + induced drag over aoa, wave drag is separate.
+	inline void Vertical(double aoa, double& cl, double& cm, double& cd, InducedDragFunc induced = InducedDrag)
+	{
+		int i;
+		const int nabsc = 9;
+		static const double AOA[nabsc] = { -180 * DEG, -60 * DEG, -30 * DEG, -2 * DEG, 15 * DEG, 20 * DEG, 25 * DEG, 60 * DEG, 180 * DEG };
+		static const double CL[nabsc] = { 0, 0, -0.4, 0, 0.7, 1, 0.8, 0, 0 };
+		static const double CM[nabsc] = { 0, 0, 0.014, 0.0039, -0.006, -0.008, -0.010, 0, 0 };
+		for (i = 0; i < nabsc - 1 && AOA[i + 1] < aoa; i++);
+		double f = (aoa - AOA[i]) / (AOA[i + 1] - AOA[i]);
+		cl = CL[i] + (CL[i + 1] - CL[i]) * f;  // aoa-dependent lift coefficient
+		cm = CM[i] + (CM[i + 1] - CM[i]) * f;  // aoa-dependent moment coefficient
+		double saoa = sin(aoa);
+		double pd = 0.015 + 0.4*saoa*saoa;  // profile drag
+		cd = pd + induced(cl, VERT_WING_AR, VERT_WIND_EFFICIENCY);
+	}
+
+	// Borrowed from DeltaGlider.  Lift and profile + induced drag over beta, wave drag is separate.
+	inline void Horizontal(double beta, double& cl, double& cd, InducedDragFunc induced = InducedDrag)
+	{
+		int i;
+		const int nabsc = 8;
+		static const double BETA[nabsc] = { -180 * DEG, -135 * DEG, -90 * DEG, -45 * DEG, 45 * DEG, 90 * DEG, 135 * DEG, 180 * DEG };
+		static const double CL[nabsc] = { 0, +0.3, 0, -0.3, +0.3, 0, -0.3, 0 };
+		for (i = 0; i < nabsc - 1 && BETA[i + 1] < beta; i++);
+		cl = CL[i] + (CL[i + 1] - CL[i]) * (beta - BETA[i]) / (BETA[i + 1] - BETA[i]);
+		cd = 0.015 + induced(cl, HORZ_WING_AR, HORZ_WING_EFFICIENCY);
+	}
+
+	/**
+	Tables
+	The model sampled into tables, what the airfoils use when there is no aero database.  Every
+	breakpoint lands on the grid, the drag terms that depend on aoa/beta (profile and induced) are
+	folded into those tables and the wave drag gets its own table over mach.  Built once, from the
+	drag functions given, then read only.
+	*/
+	class Tables
+	{
+	public:
+		void build(InducedDragFunc induced, WaveDragFunc wave)
+		{
+			vert_.build(-PI_, PI_, AOA_STEP, [induced](double aoa, bc_orbiter::uniform_table<3>::sample& s) {
+				aero_model::Vertical(aoa, s[0], s[1], s[2], induced);
+			});
+			horz_.build(-PI_, PI_, AOA_STEP, [induced](double beta, bc_orbiter::uniform_table<2>::sample& s) {
+				aero_model::Horizontal(beta, s[0], s[1], induced);
+			});
+			wave_.build(0.0, MACH_TABLE_MAX, MACH_STEP, [wave](double M, bc_orbiter::uniform_table<1>::sample& s) {
+				s = { WaveDrag(M, wave) };
+			});
+			waveFunc_ = wave;
+		}
+
+		bool is_built() const { return vert_.is_built(); }
+
+		void Vertical(double aoa, double M, double& cl, double& cm, double& cd) const
+		{
+			auto s = vert_(aoa);
+			cl = s[0];
+			cm = s[1];
+			cd = s[2] + Wave(M);
+		}
+
+		void Horizontal(double beta, double M, double& cl, double& cm, double& cd) const
+		{
+			auto s = horz_(beta);
+			cl = s[0];
+			cm = 0.0;
+			cd = s[1] + Wave(M);
+		}
+
+	private:
+		static constexpr double AOA_STEP		= 0.25 * DEG;
+		static constexpr double MACH_STEP		= 0.005;
+		static constexpr double MACH_TABLE_MAX	= 30.0;		// Above this wave drag is worked out directly.
+
+		double Wave(double M) const
+		{
+			return (M < MACH_TABLE_MAX) ? wave_(M)[0] : WaveDrag(M, waveFunc_);
+		}
+
+		bc_orbiter::uniform_table<3>	vert_;		// cl, cm, profile + induced cd over aoa.
+		bc_orbiter::uniform_table<2>	horz_;		// cl, profile + induced cd over beta.
+		bc_orbiter::uniform_table<1>	wave_;		// Wave drag over mach.
+		WaveDragFunc					waveFunc_{ nullptr };
+	};
+}
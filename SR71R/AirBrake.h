@@ -19,7 +19,7 @@
 #include "../bc_orbiter/vessel.h"
 #include "../bc_orbiter/Component.h"
 #include "../bc_orbiter/Animation.h"
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/simple_event.h"
 #include "../bc_orbiter/status_display.h"
 
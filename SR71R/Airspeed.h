@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/air_data_computer.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/signals.h"
 #include "../bc_orbiter/vessel.h"
 #include "../bc_orbiter/status_display.h"
@@ -31,8 +32,9 @@ class Airspeed :
 {
 public:
 
-	Airspeed(bco::vessel& vessel, Avionics& avionics) : 
-		avionics_(avionics)
+	Airspeed(bco::vessel& vessel, Avionics& avionics, bco::air_data_computer& airData) : 
+		  avionics_(avionics)
+		, airData_(airData)
 	{
 		vessel.AddControl(&kiesHand_);
 		vessel.AddControl(&machHand_);
@@ -59,53 +61,41 @@ public:
 		double  keas			= 0.0;		// equivalent airspeed, shows in TDI
 		double  kias			= 0.0;		// indicated, shows as dial.
 		double  mach			= 0.0;		// shows in TDI and as a dial
-		double  maxMach			= 0.0;		// Error bar on dial
 		double  speedRatio		= 0.0;		// 
 		double  maxMachRatio	= 0.0;
-		double  kiasSpeed		= 0.0;
 		bool	isOverSpeed		= false;
 
 		if (avionics_.IsAeroActive()) {
-			keas = bco::GetVesselKeas(&vessel);
-			kias = bco::GetVesselKias(&vessel);
-			mach = vessel.GetMachNumber();
-			auto atmDens = vessel.GetAtmDensity();
-
-			if (atmDens > 0.0)
-			{
-				maxMach = sqrt(MaxPress / atmDens) / 331.34;
-				isOverSpeed = mach > maxMach;
-			}
+			keas = airData_.KeasSignal().current();
+			kias = airData_.KiasSignal().current();
+			mach = airData_.MachSignal().current();
 
-			auto machGauge = (mach > MAX_MACH) ? MAX_MACH : mach;		// machGauge will be pinned, mach itself will be used to set the dials, so it not pinned.
+			auto maxMach = airData_.MaxMachSignal().current();
+			isOverSpeed = (maxMach > 0.0) && (mach > maxMach);
 
-			if (!avionics_.IsAeroAtmoMode())  // if exo mode, use velocity for machGauge
-			{
-				machGauge = vessel.GetAirspeed() / 100;
-				maxMach = 22.0;
+			if (avionics_.IsAeroAtmoMode()) {
+				speedRatio = airData_.MachRatioSignal().current();
+				maxMachRatio = airData_.MaxMachRatioSignal().current();
 			}
+			else {
+				// Exo mode, the mach hand shows velocity and max mach is pinned.
+				speedRatio = log((vessel.GetFlightState().airspeed() / 100) + 1.0) / l22;
+				maxMachRatio = 1.0;
+			}
+		}
 
-			// Set WARNING MAX MACH gauge : MACH scale is log base 22 (max mach):
-			// LOG range 1 to 23 (22 positions) to avoid <1 values.
-
-			// Calculate the max mach needle.
-			if (maxMach > 22.0) maxMach = 22.0;		// Pin MAX to 22 and 1
-			if (maxMach < 0.0) maxMach = 0.0;
-			maxMachRatio = (maxMach == 0.0)
-				? 0.0 
-				: ((log(maxMach + 1) / l22) * MAX_PIN_RAD) / MAX_PIN_RAD;	// Determine LOG based on speed then convert to 0-1 ration for the gauge.
+		// KEAS and mach barrels.
+		const double values[] = { keas, mach };
+		bco::TensParts parts[2];
+		bco::GetDigits(values, parts, 2);
 
-			// Kies dial
-			speedRatio = ((log(machGauge + 1.0) / l22) * MAX_PIN_RAD) / MAX_PIN_RAD;
-			auto kRatio = kias / 600; // 600 max kias speed
-			kiasSpeed = (avionics_.IsAeroAtmoMode()) ? (speedRatio - kRatio) : speedRatio;	// If atmo, subtract the speedRatio to get correct rotation.
-		}
+		tdiKeasOnes_.set_position(parts[0].Tens);
+		tdieasTens_.set_position(parts[0].Hundreds);
+		tdiKeasHunds_.set_position(parts[0].Thousands);
 
-		bco::TensParts parts;
-		bco::GetDigits(keas, parts);
-		tdiKeasOnes_.set_position(parts.Tens);
-		tdieasTens_.set_position(parts.Hundreds);
-		tdiKeasHunds_.set_position(parts.Thousands);
+		tdiMhOnes_.set_position(parts[1].Tenths);
+		tdiMhTens_.set_position(parts[1].Tens);
+		tdiMhHunds_.set_position(parts[1].Hundreds);
 
 		maxMachHand_.set_state(maxMachRatio);
 		machHand_.set_state(speedRatio);
@@ -113,11 +103,6 @@ public:
 
 //		sprintf(oapiDebugString(), "speedRatio (mach hand): %+4.2f", speedRatio);
 
-		bco::GetDigits(mach, parts);
-		tdiMhOnes_.set_position(parts.Tenths);
-		tdiMhTens_.set_position(parts.Tens);
-		tdiMhHunds_.set_position(parts.Hundreds);
-
 		status_.set_state(isOverSpeed ? bco::status_display::status::error : bco::status_display::status::off);
 
 		enabledFlag_.set_state(avionics_.IsAeroActive());
@@ -128,15 +113,15 @@ public:
 			: true);
 	}
 
+	// Air data computer configuration for the speed gauges.
+	static constexpr double MaxPress	= 60000.0; // 30.0 * 1000 * 2 = 60000 --> a guess at the dynamic values of SR71r.
+	static constexpr double MAX_MACH	= 22.0;
+
 private:
-	Avionics& avionics_;
-
-	const double MaxPress = 60000.0; // 30.0 * 1000 * 2 = 60000 --> a guess at the dynamic values of SR71r.
-	// ** SPEED **
-	const double MIN_PIN		=  0.0;
-	const double MAX_PIN_RAD	=  5.236; // 300.0 deg
-	const double MAX_MACH		= 22.0;
-	double l22 = log(23);
+	Avionics&					avionics_;
+	bco::air_data_computer&		airData_;
+
+	double l22 = log(MAX_MACH + 1);
 
 	using dial = bco::rotary_display_target;
 	using roll = bco::flat_roll;
@@ -16,7 +16,7 @@
 
 #pragma once
 
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/signals.h"
 #include "../bc_orbiter/vessel.h"
 #include "../bc_orbiter/rotary_display.h"
@@ -56,9 +56,8 @@ public:
 	void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override {
 		double altFeet = 0.0;
 		if (avionics_.IsAeroActive()) {
-			auto altMode = avionics_.IsAeroAtmoMode() ? AltitudeMode::ALTMODE_GROUND : AltitudeMode::ALTMODE_MEANRAD;
-			int res = 0;
-			auto alt = vessel.GetAltitude(altMode, &res);
+			auto& fs = vessel.GetFlightState();
+			auto alt = avionics_.IsAeroAtmoMode() ? fs.altitude_ground() : fs.altitude();
 			altFeet = alt * 3.28084;
 		}
 
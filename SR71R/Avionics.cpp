@@ -16,7 +16,7 @@
 
 #include "StdAfx.h"
 
-#include "..\bc_orbiter\vessel.h"
+#include "../bc_orbiter/vessel.h"
 
 #include "Avionics.h"
 
@@ -67,13 +67,14 @@ void Avionics::handle_post_step(bco::vessel& vessel, double simt, double simdt,
 	isAtmoMode_ = switchAvionMode_.is_on();
 
 	if (isAeroDataActive_) {
+		auto& fs	= vessel.GetFlightState();
 		gforce		= bco::GetVesselGs(vessel);
 		trim		= vessel.GetControlSurfaceLevel(AIRCTRL_ELEVATORTRIM);
-		aoa			= vessel.GetAOA();
-		vertSpeed	= bco::GetVerticalSpeedFPM(&vessel);
-		pitch		= vessel.GetPitch();
-		bank		= vessel.GetBank();
-		dynPress	= vessel.GetDynPressure();
+		aoa			= fs.aoa();
+		vertSpeed	= fs.vertical_speed_fpm();
+		pitch		= fs.pitch();
+		bank		= fs.bank();
+		dynPress	= fs.dyn_pressure();
 	}
 
 	// Vertical speed:
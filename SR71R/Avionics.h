@@ -16,7 +16,7 @@
 
 #pragma once
 
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/signals.h"
 #include "../bc_orbiter/on_off_input.h"
 #include "../bc_orbiter/on_off_display.h"
@@ -56,9 +56,9 @@ public:
     bool	IsAeroAtmoMode() const { return isAtmoMode_; }
 
     // Signals:
-    bco::signal<double>& SetCourseSignal() { return setCourseSignal_; }
+    bco::deferred_signal<double>& SetCourseSignal() { return setCourseSignal_; }
 
-    bco::signal<double>& SetHeadingSignal() { return setHeadingSignal_; }
+    bco::deferred_signal<double>& SetHeadingSignal() { return setHeadingSignal_; }
     bco::slot<double>& SetHeadingSlot() { return setHeadingSlot_; }
 
     bco::signal<double>& GForceSignal() { return gforceSignal_; }
@@ -74,9 +74,9 @@ private:
     bool		isAtmoMode_;
 
     // Signals:
-    bco::signal<double>		setCourseSignal_;
+    bco::deferred_signal<double>	setCourseSignal_;
 
-    bco::signal<double>		setHeadingSignal_;
+    bco::deferred_signal<double>	setHeadingSignal_;
     bco::slot<double>		setHeadingSlot_;
 
     bco::signal<double>		gforceSignal_;
@@ -16,11 +16,11 @@
 
 #pragma once
 
-#include "OrbiterSDK.h"
+#include "Orbitersdk.h"
 
 #include "../bc_orbiter/Animation.h"
 #include "../bc_orbiter/vessel.h"
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/on_off_input.h"
 #include "../bc_orbiter/status_display.h"
 
@@ -17,7 +17,7 @@
 #pragma once
 
 #include "../bc_orbiter/vessel.h"
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/signals.h"
 #include "../bc_orbiter/rotary_display.h"
 #include "../bc_orbiter/simple_event.h"
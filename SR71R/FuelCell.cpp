@@ -35,24 +35,18 @@ void FuelCell::handle_post_step(bco::vessel& vessel, double simt, double simdt,
 {
 	if (!IsPowered())
 	{
+		lox_.set_draw_rate(0.0);
+		hydro_.set_draw_rate(0.0);
 		SetIsFuelCellPowerAvailable(false);
 	}
 	else
 	{
+		// Rates per second, the tanks integrate them over their own steps.
 		auto ampFac = power_.amp_load();
+		lox_.set_draw_rate(OXYGEN_BURN_RATE_PER_SEC_100A * ampFac);
+		hydro_.set_draw_rate(HYDROGEN_BURN_RATE_PER_SEC_100A * ampFac);
 
-		auto isLOX = lox_.level() > 0.0;
-		auto isHYD = hydro_.level() > 0.0;
-
-		if (isLOX) {
-			lox_.draw(OXYGEN_BURN_RATE_PER_SEC_100A * ampFac);
-		}
-
-		if (isHYD) {
-			hydro_.draw(HYDROGEN_BURN_RATE_PER_SEC_100A * ampFac);
-		}
-
-		SetIsFuelCellPowerAvailable(isLOX && isHYD);
+		SetIsFuelCellPowerAvailable((lox_.level() > 0.0) && (hydro_.level() > 0.0));
 	}
 
 	sigAvailPower_.fire(isFuelCellAvailable_ ? MAX_VOLTS : 0.0);
@@ -20,7 +20,7 @@
 
 #include "../bc_orbiter/Animation.h"
 #include "../bc_orbiter/vessel.h"
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/on_off_input.h"
 #include "../bc_orbiter/on_off_display.h"
 
@@ -16,7 +16,7 @@
 
 #pragma once
 
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/signals.h"
 #include "../bc_orbiter/vessel.h"
 #include "../bc_orbiter/rotary_display.h"
@@ -71,7 +71,7 @@ public:
 		bool		comStatus	= false;	// from CalcNavMetrics
 
 		if (avionics_.IsAeroActive()) {
-			yaw = vessel.GetYaw();
+			yaw = vessel.GetFlightState().yaw();
 			rotHdg = yaw - slotSetHeading_.value();
 			rotCrs = yaw - slotSetCourse_.value();
 
@@ -82,16 +82,21 @@ public:
 			}
 		}
 
-		// Set course barrels
+		// Course and miles barrels
 		auto deg = slotSetCourse_.value();
-		bco::TensParts parts;
-		bco::GetDigits(deg * DEG, parts);
+		const double values[] = { deg * DEG, milesBeacon };
+		bco::TensParts parts[2];
+		bco::GetDigits(values, parts, 2);
 
-		// sprintf(oapiDebugString(), "CRS %+4f %+4f %+4f %+4f", deg, parts.Thousands, parts.Hundreds, parts.Tens );
+		// sprintf(oapiDebugString(), "CRS %+4f %+4f %+4f %+4f", deg, parts[0].Thousands, parts[0].Hundreds, parts[0].Tens );
 
-		CRSOnes_.set_position(parts.Tens / 10);
-		CRSTens_.set_position(parts.Hundreds / 10);
-		CRSHunds_.set_position(parts.Thousands / 10);
+		CRSOnes_.set_position(parts[0].Tens / 10);
+		CRSTens_.set_position(parts[0].Hundreds / 10);
+		CRSHunds_.set_position(parts[0].Thousands / 10);
+
+		MilesOnes_.set_position(parts[1].Tens);
+		MilesTens_.set_position(parts[1].Hundreds);
+		MilesHunds_.set_position(parts[1].Thousands);
 
 		signalGlideScope_.fire(glideSlope);
 		
@@ -104,12 +109,6 @@ public:
 
 		comStatusFlag_.set_state(comStatus);
 
-		// Miles barrels
-		bco::GetDigits(milesBeacon, parts);
-		MilesOnes_.set_position(parts.Tens);
-		MilesTens_.set_position(parts.Hundreds);
-		MilesHunds_.set_position(parts.Thousands);
-
 		hsiOffFlag_.set_state(avionics_.IsAeroActive());
 		hsiExoFlag_.set_state(
 			!avionics_.IsAeroActive()
@@ -173,7 +172,7 @@ private:
 			navError = devB / Range * Slide;
 
 			// Glide slope
-			slope = atan2(vessel.GetAltitude(), navDistance);
+			slope = atan2(vessel.GetFlightState().altitude(), navDistance);
 
 			const double tgtslope = 3.0 * RAD;
 			const double tgtvar = 0.6 * RAD;
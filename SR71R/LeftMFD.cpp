@@ -98,18 +98,13 @@ bool LeftMFD::handle_load_vc(bco::vessel& vessel, int vcid)
     // MNU
     oapiVCRegisterArea(GetMenuKey(), PANEL_REDRAW_NEVER, PANEL_MOUSE_LBDOWN | PANEL_MOUSE_ONREPLAY);
     oapiVCSetAreaClickmode_Spherical(GetMenuKey(), bm::vc::MFCLeftMNU_loc, MFDBRAD);
+    LoadLabelSurface(surfHandle);
     return true;
 }
 
 bool LeftMFD::OnVCRedrawEvent(int id, int event, SURFHANDLE surf)
 {
-    bco::DrawBlankText(10, 13, surf, vcFont_);
-
-    const char* label = GetButtonLabel(id);
-    if (NULL != label) {
-        bco::DrawSurfaceText(30, 13, label, bco::DrawTextFormat::Center, surf, vcFont_);
-    }
-
+    DrawLabel(id, 30, 13, surf, vcFont_);
     return true;
 }
 
@@ -183,6 +178,7 @@ bool LeftMFD::handle_load_panel(bco::vessel& vessel, int id, PANELHANDLE hPanel)
         PANEL_REDRAW_NEVER,
         PANEL_MOUSE_LBDOWN | PANEL_MOUSE_ONREPLAY);
 
+    LoadLabelSurface(surfHandle);
     return true;
 }
 
@@ -191,14 +187,8 @@ bool LeftMFD::OnPanelRedrawEvent(int id, int event, SURFHANDLE surf)
     auto m = std::find_if(data_.begin(), data_.end(), [&](const MFDData& o) { return o.id == id; });
     if (m == data_.end()) return false;
 
-    const char* label = GetButtonLabel(id);
-
     auto xPos = PnlColLeftX + (m->col * PnlColsDiff);
     auto yPos = PnlRowsTop + (m->row * PnlRowsDiff);
-    bco::DrawBlankText(xPos - 20, yPos, surf, vcFont_);
-
-    if (NULL != label) {
-        bco::DrawSurfaceText(xPos, yPos, label, bco::DrawTextFormat::Center, surf, vcFont_);
-    }
+    DrawLabel(id, xPos, yPos, surf, vcFont_);
     return true;
 }
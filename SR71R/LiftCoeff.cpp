@@ -19,33 +19,91 @@
 #include "LiftCoeff.h"
 #include "ShipMets.h"
 
-// Borrowed from DeltaGlider.
+#include "../bc_orbiter/aero_database.h"
+
+#include <fstream>
+
+namespace bco = bc_orbiter;
+
+// Orbiter calls the coefficient functions several times per frame for each airfoil.  When the aero
+// database is present its aoa x mach grids are used, otherwise the tables of the built in model
+// (AeroModel.h), which InitLiftCoeff builds with Orbiter's own induced and wave drag.  Both are read
+// only after InitLiftCoeff, the only per call state is the aero_hint passed as the airfoil context,
+// so the functions are reentrant.
+namespace {
+	const char*  AERO_DATABASE	= "Config\\Vessels\\SR71r_aero.csv";
+
+	aero_model::Tables			builtinTables;
+
+	bco::aero_database			aeroDatabase;
+	const bco::aero_grid*		vertGrid = nullptr;
+	const bco::aero_grid*		horzGrid = nullptr;
+
+	void GridCoeff(const bco::aero_grid& grid, double aoa, double M, void* context, double* cl, double* cm, double* cd)
+	{
+		bco::aero_hint local;
+		auto hint = (context != nullptr) ? static_cast<bco::aero_hint*>(context) : &local;
+
+		auto c = grid.evaluate(aoa, M, *hint);
+		*cl = c.cl;
+		*cm = c.cm;
+		*cd = c.cd;
+	}
+}
+
+void InitLiftCoeff()
+{
+	static bool isLoaded = false;	// Shared by all vessels of the class.
+	if (isLoaded) return;
+	isLoaded = true;
+
+	builtinTables.build(oapiGetInducedDrag, oapiGetWaveDrag);
+	LoadLiftCoeff(AERO_DATABASE);
+}
+
+bool LoadLiftCoeff(const char* path)
+{
+	vertGrid = horzGrid = nullptr;
+	if (path == nullptr) return false;
+
+	std::ifstream in(path);
+	if (!in) {
+		oapiWriteLogV("SR71r: %s not found, using the built in aero model.", path);
+		return false;
+	}
+
+	std::string error;
+	if (!aeroDatabase.load(in, error)) {
+		oapiWriteLogV("SR71r: %s: %s, using the built in aero model.", path, error.c_str());
+		return false;
+	}
+
+	vertGrid = aeroDatabase.find("vertical");
+	horzGrid = aeroDatabase.find("horizontal");
+	if ((vertGrid == nullptr) || (horzGrid == nullptr)) {
+		oapiWriteLogV("SR71r: %s needs 'vertical' and 'horizontal' airfoils, using the built in aero model.", path);
+		vertGrid = horzGrid = nullptr;
+		return false;
+	}
+	return true;
+}
+
 void VLiftCoeff(VESSEL *v, double aoa, double M, double Re, void *context, double *cl, double *cm, double *cd)
 {
-	int i;
-	const int nabsc = 9;
-	static const double AOA[nabsc] = { -180 * RAD, -60 * RAD, -30 * RAD, -2 * RAD, 15 * RAD, 20 * RAD, 25 * RAD, 60 * RAD, 180 * RAD };
-	static const double CL[nabsc] = { 0, 0, -0.4, 0, 0.7, 1, 0.8, 0, 0 };
-	static const double CM[nabsc] = { 0, 0, 0.014, 0.0039, -0.006, -0.008, -0.010, 0, 0 };
-	for (i = 0; i < nabsc - 1 && AOA[i + 1] < aoa; i++);
-	double f = (aoa - AOA[i]) / (AOA[i + 1] - AOA[i]);
-	*cl = CL[i] + (CL[i + 1] - CL[i]) * f;  // aoa-dependent lift coefficient
-	*cm = CM[i] + (CM[i + 1] - CM[i]) * f;  // aoa-dependent moment coefficient
-	double saoa = sin(aoa);
-	double pd = 0.015 + 0.4*saoa*saoa;  // profile drag
-	*cd = pd + oapiGetInducedDrag(*cl, VERT_WING_AR, VERT_WIND_EFFICIENCY) + oapiGetWaveDrag(M, 0.75, 1.0, 1.1, 0.04);
-	// profile drag + (lift-)induced drag + transonic/supersonic wave (compressibility) drag
+	if (vertGrid != nullptr) {
+		GridCoeff(*vertGrid, aoa, M, context, cl, cm, cd);
+		return;
+	}
+
+	builtinTables.Vertical(aoa, M, *cl, *cm, *cd);
 }
 
-// Borrowed from DeltaGlider.
 void HLiftCoeff(VESSEL *v, double beta, double M, double Re, void *context, double *cl, double *cm, double *cd)
 {
-	int i;
-	const int nabsc = 8;
-	static const double BETA[nabsc] = { -180 * RAD, -135 * RAD, -90 * RAD, -45 * RAD, 45 * RAD, 90 * RAD, 135 * RAD, 180 * RAD };
-	static const double CL[nabsc] = { 0, +0.3, 0, -0.3, +0.3, 0, -0.3, 0 };
-	for (i = 0; i < nabsc - 1 && BETA[i + 1] < beta; i++);
-	*cl = CL[i] + (CL[i + 1] - CL[i]) * (beta - BETA[i]) / (BETA[i + 1] - BETA[i]);
-	*cm = 0.0;
-	*cd = 0.015 + oapiGetInducedDrag(*cl, HORZ_WING_AR, HORZ_WING_EFFICIENCY) + oapiGetWaveDrag(M, 0.75, 1.0, 1.1, 0.04);
+	if (horzGrid != nullptr) {
+		GridCoeff(*horzGrid, beta, M, context, cl, cm, cd);
+		return;
+	}
+
+	builtinTables.Horizontal(beta, M, *cl, *cm, *cd);
 }
@@ -17,5 +17,18 @@
 #pragma once
 #include "Orbitersdk.h"
 
+#include "../bc_orbiter/aero_database.h"
+
+// Builds the built in model's tables from oapiGetInducedDrag and oapiGetWaveDrag and loads the aero
+// database (Config\Vessels\SR71r_aero.csv, see Tools\AeroTable) if one is installed, the built in
+// model is used when it is missing.  None is shipped.  Call before creating the airfoils.
+void InitLiftCoeff();
+
+// Loads the aero database at 'path' in place of the one loaded, false (and logged) if the built in
+// model is used instead, null goes back to the built in model.  After InitLiftCoeff and not while
+// airfoils are using the coefficients, InitLiftCoeff is the normal way in.
+bool LoadLiftCoeff(const char* path);
+
+// The airfoil context given to CreateAirfoil3 with these is a bc_orbiter::aero_hint owned by the vessel, or null.
 void VLiftCoeff(VESSEL *v, double aoa, double M, double Re, void *context, double *cl, double *cm, double *cd);
 void HLiftCoeff(VESSEL *v, double beta, double M, double Re, void *context, double *cl, double *cm, double *cd);
@@ -16,9 +16,9 @@
 
 #pragma once
 
-#include "..\bc_orbiter\control.h"
-#include "..\bc_orbiter\handler_interfaces.h"
-#include "..\bc_orbiter\vessel.h"
+#include "../bc_orbiter/Control.h"
+#include "../bc_orbiter/handler_interfaces.h"
+#include "../bc_orbiter/vessel.h"
 
 #include "SR71r_mesh.h"
 #include "SR71r_common.h"
@@ -36,9 +36,9 @@ class Lights :
 
 public:
     Lights(bco::vessel& vessel, bco::power_provider& pwr) : power_(pwr) {
-        switchStrobeLights_.attach_on_change([&]() { update(); });
-        switchBeaconLights_.attach_on_change([&]() { update(); });
-        switchNavigationLights_.attach_on_change([&]() { update(); });
+        switchStrobeLights_.attach_on_change([&]() { update(); power_.draw_changed(this); });
+        switchBeaconLights_.attach_on_change([&]() { update(); power_.draw_changed(this); });
+        switchNavigationLights_.attach_on_change([&]() { update(); power_.draw_changed(this); });
 
         power_.attach_consumer(this);
         
@@ -56,6 +56,7 @@ public:
         total += switchNavigationLights_.is_on() ? 4.0 : 0.0;
         return total;
     }
+    bool reports_draw() const override { return true; }
 
     // set_class_caps
     void handle_set_class_caps(bco::vessel& vessel) {
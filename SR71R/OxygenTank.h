@@ -17,7 +17,7 @@
 #pragma once
 
 #include "../bc_orbiter/vessel.h"
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/rotary_display.h"
 #include "../bc_orbiter/on_off_input.h"
 #include "../bc_orbiter/on_off_display.h"
@@ -33,8 +33,8 @@ class OxygenTank :
     public bco::generic_tank
 {
 public:
-    OxygenTank(bco::power_provider& pwr, bco::vessel& vessel) :
-        bco::generic_tank(pwr, O2_SUPPLY, OXYGEN_FILL_RATE)
+    OxygenTank(bco::power_provider& pwr, bco::vessel& vessel, bco::resource_table& resources) :
+        bco::generic_tank(resources, pwr, O2_SUPPLY, OXYGEN_FILL_RATE, O2_NER)
     {
         vessel.AddControl(&gaugeLevel_);
         vessel.AddControl(&lightAvailable_);
@@ -23,9 +23,13 @@
 #include <assert.h>
 
 PowerSystem::PowerSystem(bco::vessel& vessel) :
-	batteryLevel_(1.0),			// Always available for now.
+	mainBus_(network_.add_bus("MAIN")),
 	slotFuelCellAvailablePower_([&](double v) { })
 {
+	srcExternal_ = network_.add_source(mainBus_);
+	srcFuelCell_ = network_.add_source(mainBus_);
+	srcBattery_ = network_.add_battery(mainBus_, BATTERY_AH, FULL_POWER, BATTERY_CHARGE_AMPS);
+
 	vessel.AddControl(&switchEnabled);
 	vessel.AddControl(&switchConnectExternal_);
 	vessel.AddControl(&switchConnectFuelCell_);
@@ -44,13 +48,16 @@ bool PowerSystem::handle_load_state(bco::vessel& vessel, const std::string& line
 
 	std::stringstream ss(line);
 	ss >> switchEnabled >> switchConnectExternal_ >> switchConnectFuelCell_ >> volt >> bl;
+
+	double battery;		// Battery charge was added later, older scenarios start with a full battery.
+	if (ss >> battery) network_.set_battery_level(srcBattery_, battery);
 	return true;
 }
 
 std::string PowerSystem::handle_save_state(bco::vessel& vessel)
 {
 	std::stringstream ss;
-	ss << switchEnabled << " " << switchConnectExternal_ << " " << switchConnectFuelCell_ << " 0.0 0.0";
+	ss << switchEnabled << " " << switchConnectExternal_ << " " << switchConnectFuelCell_ << " 0.0 0.0 " << network_.battery_level(srcBattery_);
 	return ss.str();
 }
 
@@ -59,55 +66,40 @@ std::string PowerSystem::handle_save_state(bco::vessel& vessel)
 //	mainCircuit_.AddDevice(device);
 //}
 
-void PowerSystem::Update(bco::vessel& vessel)
+void PowerSystem::Update(bco::vessel& vessel, double simdt)
 {
 	/* Power system update:
-	*	Determine if we have a power source available and how much it provides.
-	*	Check the current amp total and determine if we have an overload.
-	*	Report the voltage available signal so components know what they have to work with.
+	*	Set the sources from the switches and what is available, then step the network which
+	*	tracks the load and re-solves the bus volts when something changed.  Consumers are
+	*	notified of a volts change by the bus.
 	*/
 	auto externalConnected = vessel.IsStoppedOrDocked();
 	lightExternalAvail_.set_state(externalConnected);
 
-	// handle connected power
-	auto availExternal = 
-		externalConnected &&				// External power is available
-		switchConnectExternal_.is_on() 		// External power is connected to the bus
-		? FULL_POWER : 0.0;
+	auto isMainOn = switchEnabled.is_on();
 
-	lightExternalConnected_.set_state(availExternal > USEABLE_POWER);
+	// handle connected power
+	network_.set_source_volts(srcExternal_, externalConnected ? FULL_POWER : 0.0);
+	network_.set_source_connected(srcExternal_, isMainOn && switchConnectExternal_.is_on());
+	lightExternalConnected_.set_state(externalConnected && switchConnectExternal_.is_on());
 
 	// handle fuelcell power
-	auto availFuelCell = switchConnectFuelCell_.is_on() ? slotFuelCellAvailablePower_.value() : 0.0;
-	lightFuelCellConnected_.set_state(availFuelCell > USEABLE_POWER);
+	auto availFuelCell = slotFuelCellAvailablePower_.value();
+	network_.set_source_volts(srcFuelCell_, availFuelCell);
+	network_.set_source_connected(srcFuelCell_, isMainOn && switchConnectFuelCell_.is_on());
+	lightFuelCellConnected_.set_state(switchConnectFuelCell_.is_on() && (availFuelCell > USEABLE_POWER));
 
-	// handle battery power
-	auto availBattery = batteryLevel_ * FULL_POWER;
-	auto availPower = 0.0;
-	isDrawingBattery_ = false;
+	// handle battery power, used when neither of the above is useable.
+	network_.set_source_connected(srcBattery_, isMainOn);
 
-	if (switchEnabled.is_on())
-	{
-		availPower = fmax(availExternal, availFuelCell);
-		if (availPower < USEABLE_POWER) {
-			isDrawingBattery_ = true;
-			availPower = availBattery;
-		}
-	}
+	network_.step(simdt);
+	isDrawingBattery_ = network_.is_supplying(srcBattery_);
 
-	if (availPower != prevVolts_) {
-		prevVolts_ = availPower;
-
-		for (auto & c : consumers_) {
-			c->on_change(prevVolts_);
-		}
-	}
-
-	gaugePowerVolts_.set_state(availPower / FULL_POWER);
+	gaugePowerVolts_.set_state(mainBus_.volts_available() / FULL_POWER);
 
 	statusBattery_.set_state(
-		(switchEnabled.is_on() && isDrawingBattery_)
+		(isMainOn && isDrawingBattery_)
 		?	bco::status_display::status::warn
 		:	bco::status_display::status::off
 	);
-}
\ No newline at end of file
+}
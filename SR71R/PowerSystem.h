@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "../bc_orbiter/electrical_network.h"
 #include "../bc_orbiter/signals.h"
 #include "../bc_orbiter/on_off_input.h"
 #include "../bc_orbiter/on_off_display.h"
@@ -43,6 +44,11 @@ class FuelCell;
 	Hook a reciever slot up to the VoltLevelSignal() and an amp signal up to the AmpDrawSlot().
 	On a change to the receiver slot, check that the new voltage level is adequate.
 	On each step, report through the amp signal the current amp usage for that component.
+
+	The sources and the MAIN bus are an electrical_network: external and fuel cell are primary
+	sources, the battery is the backup and follows its discharge curve as it is drawn down.  The main
+	switch connects the sources to the bus.  Consumers attached to the power system go on MAIN, see
+	electrical_bus for how their load is tracked.
 */
 class PowerSystem :
     public bco::vessel_component
@@ -56,15 +62,10 @@ public:
     // post_step
     void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override
     {
-        double draw = 0.0;
-
-        for (auto & c : consumers_) {
-            draw += c->amp_draw();
-        }
+        Update(vessel, simdt);
 
-        ampDraw_ = fmin(draw, AMP_OVERLOAD);
+        ampDraw_ = fmin(network_.total_load(), AMP_OVERLOAD);
         gaugePowerAmps_.set_state(ampDraw_ / AMP_OVERLOAD);
-        Update(vessel);
     }
 
     // manage_state
@@ -74,30 +75,42 @@ public:
     // Fuelcell:
     bco::slot<double>& FuelCellAvailablePowerSlot() { return slotFuelCellAvailablePower_; }	// Volt quantity available from fuelcell.
 
-    void attach_consumer(bco::power_consumer* consumer) override {
-        consumers_.push_back(consumer);
-    }
-
-    double volts_available() const override { return prevVolts_; }
+    // power_provider, consumers attached to the power system go on the main bus.
+    void attach_consumer(bco::power_consumer* consumer) override { mainBus_.attach_consumer(consumer); }
+    void draw_changed(bco::power_consumer* consumer) override { mainBus_.draw_changed(consumer); }
+    double volts_available() const override { return mainBus_.volts_available(); }
     double amp_load() const override { return ampDraw_; }
 
+    /**
+    Bus by name, for consumers that attach to a bus other than MAIN.  nullptr if there is no such bus.
+    */
+    bco::power_provider* Bus(const std::string& name) { return network_.find_bus(name); }
+
+    /**
+    Main bus reporting consumers whose draw changed during the last step.
+    */
+    const std::vector<bco::power_consumer*>& ChangedConsumers() const { return mainBus_.changed_consumers(); }
+
 private:
-    void Update(bco::vessel& vessel);
+    void Update(bco::vessel& vessel, double simdt);
 
     const double			FULL_POWER = 28.0;
     const double			USEABLE_POWER = 24.0;
     const double			AMP_OVERLOAD = 100.0;
+    const double			BATTERY_AH = 40.0;
+    const double			BATTERY_CHARGE_AMPS = 5.0;
 
-    std::vector<bco::power_consumer*>  consumers_;
+    bco::electrical_network	network_{ USEABLE_POWER };
+    bco::electrical_bus&	mainBus_;
+    size_t					srcExternal_;
+    size_t					srcFuelCell_;
+    size_t					srcBattery_;
 
     bco::signal<bool>		signalIsDrawingBattery_;
     bco::slot<double>		slotFuelCellAvailablePower_;
 
     double					ampDraw_{ 0.0 };			// Collects the total amps drawn during a step.
-    double					batteryLevel_;
     bool					isDrawingBattery_{ false };
-    double					prevStep_{ 0.0 };
-    double					prevVolts_{ -1.0 };
 
     bco::on_off_input       switchEnabled{
         { bm::vc::swMainPower_id },
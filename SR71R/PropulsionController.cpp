@@ -24,11 +24,12 @@
 
 #include <assert.h>
 
-PropulsionController::PropulsionController(bco::power_provider& pwr, bco::vessel& vessel) :
+PropulsionController::PropulsionController(bco::power_provider& pwr, bco::vessel& vessel, bco::resource_table& resources) :
 	power_(pwr),
 	vessel_(vessel),
-	mainFuelLevel_(0.0),
-	rcsFuelLevel_(0.0)
+	resources_(resources),
+	mainFuel_(resources.add_tank(MAX_FUEL, FUEL_FILL_RATE)),
+	rcsFuel_(resources.add_tank(MAX_RCS_FUEL, FUEL_FILL_RATE))
 	//slotThrottleLimit_(	[&](bool v) { SetThrustLevel((v) ? ENGINE_THRUST : ENGINE_THRUST_AB); }),
 	//slotFuelDump_(		[&](bool v) { }), 
 	//slotTransferSel_(	[&](bool v) { }),
@@ -36,6 +37,17 @@ PropulsionController::PropulsionController(bco::power_provider& pwr, bco::vessel
 {
 	power_.attach_consumer(this);
 
+	resources_.set_supply(mainFuel_, power_, this, 24.0);
+	resources_.set_supply(rcsFuel_, power_, this, 24.0);
+	resources_.set_draw_floor(mainFuel_, FUEL_MINIMUM_DUMP);		// Dumping stops here.
+
+	resources_.level_signal(mainFuel_).attach(slotMainLevel_);
+	resources_.level_signal(rcsFuel_).attach(slotRCSLevel_);
+	resources_.filling_signal(mainFuel_).attach(slotMainFilling_);
+	resources_.filling_signal(rcsFuel_).attach(slotRCSFilling_);
+	resources_.available_signal(mainFuel_).attach(slotMainAvail_);
+	resources_.available_signal(rcsFuel_).attach(slotRCSAvail_);
+
 	maxMainFlow_ = (ENGINE_THRUST / THRUST_ISP) * 2;
 
 	vessel.AddControl(&switchFuelDump_);
@@ -62,66 +74,29 @@ PropulsionController::PropulsionController(bco::power_provider& pwr, bco::vessel
 
 void PropulsionController::ToggleFill()
 {
-	if (isFilling_)
-	{
-		isFilling_ = false;
-	}
-	else
-	{
-		if (IsPowered() && isExternAvail_)
-		{
-			isFilling_ = true;
-		}
-	}
+	// Filling cannot be enabled if external fuel is unavailable.
+	resources_.set_filling(mainFuel_, !resources_.is_filling(mainFuel_));
 }
 
 void PropulsionController::ToggleRCSFill()
 {
-	if (isRCSFilling_)
-	{
-		isRCSFilling_ = false;
-	}
-	else
-	{
-		if (IsPowered() && isExternAvail_)
-		{
-			isRCSFilling_ = true;
-		}
-	}
+	resources_.set_filling(rcsFuel_, !resources_.is_filling(rcsFuel_));
 }
 
 void PropulsionController::handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd)
 {
-	// Limit how often we run
-	if (fabs(simt - prevTime_) > 0.1)
-	{
-		Update((simt - prevTime_));
-		prevTime_ = simt;
-	}
+	Update();
 }
 
-void PropulsionController::Update(double deltaUpdate)
+void PropulsionController::Update()
 {
-	isExternAvail_ = (IsPowered() && vessel_.IsStoppedOrDocked());
-	lightFuelAvail_.set_state(isExternAvail_);
-	lightRCSAvail_.set_state(isExternAvail_);
-
-	if (!isExternAvail_)
-	{
-		isFilling_ = false;
-		isRCSFilling_ = false;
-	}
-
-	lightFuelValveOpen_.set_state(isFilling_);
-	lightRCSValveOpen_.set_state(isRCSFilling_);
-
-	HandleTransfer(deltaUpdate); // <- this sets the current levels.
+	// Filling, dumping and the fuel gauges are stepped by the resource table.  Dumping will happen
+	// regardless of the transfer switch position.
+	resources_.set_draw_rate(mainFuel_, (IsPowered() && switchFuelDump_.is_on()) ? FUEL_DUMP_RATE : 0.0);
 
     // Main flow
     auto flow = vessel_.GetPropellantFlowrate(vessel_.MainPropellant());
-//    auto trFlow = (flow / maxMainFlow_) * (PI2 * 0.75);	// 90.718 = 200lbs per hour : 270 deg.
 	if ((flow < 0.0) || switchFuelDump_.is_on()) flow = 0.0;	 // Don't report flow if dumping.
-//	sigFuelFlowRate_.fire(flow / maxMainFlow_);	 // Converted to 0-1 range.
 	gaugeFuelFlow_.set_state(flow / maxMainFlow_);
 
 	statusLimiter_.set_state(
@@ -130,57 +105,11 @@ void PropulsionController::Update(double deltaUpdate)
 		:	bco::status_display::status::on
 	);
 
-
-    // Main level
-//    auto trMain = GetMainFuelLevel() * (PI2 * 0.71111);	// 256 deg.
-//	sigMainFuelLevel_.fire(mainFuelLevel_);
-
-    // RCS
-//    auto trRCS = GetRcsFuelLevel() * (PI2 * 0.733);	// 264 deg.
-//	sigRCSFuelLevel_.fire(rcsFuelLevel_);
-}
-
-void PropulsionController::HandleTransfer(double deltaUpdate)
-{
-	// Determine fuel levels:
-	mainFuelLevel_  = vessel_.GetPropellantMass(vessel_.MainPropellant()) / 
-					  vessel_.GetPropellantMaxMass(vessel_.MainPropellant());
-
-	rcsFuelLevel_   = vessel_.GetPropellantMass(vessel_.RcsPropellant()) / 
-					  vessel_.GetPropellantMaxMass(vessel_.RcsPropellant());
-
-	gaugeFuelMain_.set_state(mainFuelLevel_);
-	gaugeFuelRCS_.set_state(rcsFuelLevel_);
-
-	// Dumping and filling of the main tank will happen regardless of the transfer switch position.
-	if (isFilling_) // cannot be enabled if external fuel is unavailable.
-	{
-		// Add to main.
-		auto actualFill = FillMainFuel(FUEL_FILL_RATE * deltaUpdate);
-		if (actualFill <= 0.0)
-		{
-			isFilling_ = false;
-		}
-	}
-
-	if (isRCSFilling_) {
-		auto actualFill = FillRCSFuel(FUEL_FILL_RATE * deltaUpdate);
-		if (actualFill <= 0.0) {
-			isRCSFilling_ = false;
-		}
-	}
-
-	if (IsPowered() && switchFuelDump_.is_on())
-	{
-		auto actualDump = DrawMainFuel(FUEL_DUMP_RATE * deltaUpdate);
-	}
-
-	signalMainFuelLevel_.fire(mainFuelLevel_);
-
+	auto mainFuelLevel = resources_.level(mainFuel_);
 	statusFuel_.set_state(
-		(mainFuelLevel_ > 0.2) || !IsPowered()
+		(mainFuelLevel > 0.2) || !IsPowered()
 		?	bco::status_display::status::off
-		:	mainFuelLevel_ == 0.0
+		:	mainFuelLevel == 0.0
 			?	bco::status_display::status::error
 			:	bco::status_display::status::warn);
 }
@@ -190,38 +119,6 @@ double PropulsionController::GetVesselMainThrustLevel()
 	return vessel_.GetThrusterGroupLevel(THGROUP_MAIN);
 }
 
-double PropulsionController::DrawMainFuel(double amount)
-{
-    auto mainProp = vessel_.MainPropellant();
-
-	// Subtract the minimum fuel allowed to determine what available current is.
-	auto current = vessel_.GetPropellantMass(mainProp);
-	auto currentAvail = current - FUEL_MINIMUM_DUMP;
-
-	if (currentAvail <= 0.0)
-	{
-		// Not enough fuel to dump.
-		return 0.0;
-	}
-
-	auto actual = min(amount, currentAvail);
-
-	vessel_.SetPropellantMass(mainProp, (current - actual));
-	return actual;
-}
-
-double PropulsionController::FillMainFuel(double amount)
-{
-    auto mainProp = vessel_.MainPropellant();
-
-	auto current = vessel_.GetPropellantMass(mainProp);
-	auto topOff = MAX_FUEL - current;
-
-	auto result = min(amount, topOff);
-	vessel_.SetPropellantMass(mainProp, (current + result));
-	return result;
-}
-
 double PropulsionController::DrawRCSFuel(double amount)
 {
     auto rcsProp = vessel_.RcsPropellant();
@@ -233,20 +130,11 @@ double PropulsionController::DrawRCSFuel(double amount)
 	return result;
 }
 
-double PropulsionController::FillRCSFuel(double amount)
-{
-    auto rcsProp = vessel_.RcsPropellant();
-
-	auto current = vessel_.GetPropellantMass(rcsProp);
-	auto topOff = MAX_RCS_FUEL - current;
-
-	auto result = min(amount, topOff);
-	vessel_.SetPropellantMass(rcsProp, (current + result));
-	return result;
-}
-
 void PropulsionController::handle_set_class_caps(bco::vessel& vessel)
 {
+	resources_.bind_propellant(mainFuel_, vessel.MainPropellant());
+	resources_.bind_propellant(rcsFuel_, vessel.RcsPropellant());
+
 	//	Start with max thrust (ENGINE_THRUST) this will change base on the max thrust selector.
 	mainThrustHandles_[0] = vessel.CreateThruster(
         bm::main::ThrusterP_loc,  
@@ -27,6 +27,7 @@
 #include "../bc_orbiter/simple_event.h"
 #include "../bc_orbiter/rotary_display.h"
 #include "../bc_orbiter/status_display.h"
+#include "../bc_orbiter/resource_table.h"
 
 #include "SR71r_mesh.h"
 #include "SR71r_common.h"
@@ -89,13 +90,14 @@ class PropulsionController :
 	, public bco::draw_hud
 {
 public:
-	PropulsionController(bco::power_provider& pwr, bco::vessel& vessel);
+	PropulsionController(bco::power_provider& pwr, bco::vessel& vessel, bco::resource_table& resources);
 
 	// post_step
 	void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override;
+	bco::step_rate post_step_rate() const override { return bco::step_rate::hz10; }
 
 	// power_consumer
-	double amp_draw() const { return (isFilling_ ? 4.0 : 0.0) + (isRCSFilling_ ? 4.0 : 0.0); }
+	double amp_draw() const { return (resources_.is_filling(mainFuel_) ? 4.0 : 0.0) + (resources_.is_filling(rcsFuel_) ? 4.0 : 0.0); }
 
 	// set_class_caps
 	void handle_set_class_caps(bco::vessel& vessel) override;
@@ -112,47 +114,37 @@ public:
     void SetAttitudeRotLevel(bco::Axis axis, double level);
 	double CurrentMaxThrust() { return maxThrustLevel_; }
 
-	bco::signal<double>&	MainFuelLevelSignal() { return signalMainFuelLevel_; }
+	bco::signal<double>&	MainFuelLevelSignal() { return resources_.level_signal(mainFuel_); }
 
 	void ToggleThrustLimit() { switchThrustLimit_.toggle_state(); }
 
 private:
 	bco::vessel&		vessel_;
 	bco::power_provider&	power_;
+	bco::resource_table&	resources_;
 
-	bool IsPowered() { return power_.volts_available() > 24.0; }
-
-	bco::signal<double>		signalMainFuelLevel_;
+	// Main and RCS propellant rows in the resource table, which does the filling and dumping.
+	bco::resource_table::id	mainFuel_;
+	bco::resource_table::id	rcsFuel_;
 
-	double DrawMainFuel(double amount);
-	double FillMainFuel(double amount);
+	bool IsPowered() { return power_.volts_available() > 24.0; }
 
 	double DrawRCSFuel(double amount);
-	double FillRCSFuel(double amount);
 
 	void SetThrustLevel(double newLevel);
-	void Update(double deltaUpdate);
+	void Update();
 
 	void ToggleFill();
 	void ToggleRCSFill();
 
-	void HandleTransfer(double deltaUpdate);
-
 	THRUSTER_HANDLE		mainThrustHandles_[2];
     THRUSTER_HANDLE     retroThrustHandles_[2];
 
 	double				maxMainFlow_;			// MAXTHRUST / ISP.
 
 	const char*	ConfigKey = "PROPULSION";
-	double		mainFuelLevel_;
-	double		rcsFuelLevel_;
 	double		maxThrustLevel_;
 	int			areaId_;
-	double		prevTime_;
-	bool		isFilling_			{ false };
-	bool		isExternAvail_		{ false };
-
-	bool		isRCSFilling_		{ false };
 
 	// Switches
     bco::on_off_input		switchThrustLimit_{		// Thrust Limit
@@ -270,4 +262,12 @@ private:
         bm::pnl::pnlMsgLightThrustLimit_vrt,
         0.0361
     };
+
+    // Resource table outputs.
+    bco::slot<double>       slotMainLevel_      { [&](double l) { gaugeFuelMain_.set_state(l); } };
+    bco::slot<double>       slotRCSLevel_       { [&](double l) { gaugeFuelRCS_.set_state(l); } };
+    bco::slot<bool>         slotMainFilling_    { [&](bool b) { lightFuelValveOpen_.set_state(b); } };
+    bco::slot<bool>         slotRCSFilling_     { [&](bool b) { lightRCSValveOpen_.set_state(b); } };
+    bco::slot<bool>         slotMainAvail_      { [&](bool b) { lightFuelAvail_.set_state(b); } };
+    bco::slot<bool>         slotRCSAvail_       { [&](bool b) { lightRCSAvail_.set_state(b); } };
 };
\ No newline at end of file
@@ -16,7 +16,7 @@
 
 #pragma once
 
-#include "../bc_orbiter/control.h"
+#include "../bc_orbiter/Control.h"
 #include "../bc_orbiter/simple_event.h"
 #include "../bc_orbiter/on_off_display.h"
 
@@ -92,18 +92,13 @@ bool RightMFD::handle_load_vc(bco::vessel& vessel, int vcid)
     // MNU
     oapiVCRegisterArea(GetMenuKey(), PANEL_REDRAW_NEVER, PANEL_MOUSE_LBDOWN | PANEL_MOUSE_ONREPLAY);
     oapiVCSetAreaClickmode_Spherical(GetMenuKey(), bm::vc::MFCRightMNU_loc, MFDBRAD);
+    LoadLabelSurface(surfHandle);
     return true;
 }
 
 bool RightMFD::OnVCRedrawEvent(int id, int event, SURFHANDLE surf)
 {
-    bco::DrawBlankText(10, 13, surf, vcFont_);
-
-    const char* label = GetButtonLabel(id);
-    if (NULL != label) {
-        bco::DrawSurfaceText(30, 13, label, bco::DrawTextFormat::Center, surf, vcFont_);
-    }
-
+    DrawLabel(id, 30, 13, surf, vcFont_);
     return true;
 }
 
@@ -176,6 +171,7 @@ bool RightMFD::handle_load_panel(bco::vessel& vessel, int id, PANELHANDLE hPanel
         PANEL_REDRAW_NEVER,
         PANEL_MOUSE_LBDOWN | PANEL_MOUSE_ONREPLAY);
 
+    LoadLabelSurface(surfHandle);
     return true;
 }
 
@@ -184,14 +180,8 @@ bool RightMFD::OnPanelRedrawEvent(int id, int event, SURFHANDLE surf)
     auto m = std::find_if(data_.begin(), data_.end(), [&](const MFDData& o) { return o.id == id; });
     if (m == data_.end()) return false;
 
-    const char* label = GetButtonLabel(id);
-
     auto xPos = PnlColLeftX + (m->col * PnlColsDiff);
     auto yPos = PnlRowsTop + (m->row * PnlRowsDiff);
-    bco::DrawBlankText(xPos - 20, yPos, surf, vcFont_);
-
-    if (NULL != label) {
-        bco::DrawSurfaceText(xPos, yPos, label, bco::DrawTextFormat::Center, surf, vcFont_);
-    }
+    DrawLabel(id, xPos, yPos, surf, vcFont_);
     return true;
 }
\ No newline at end of file
@@ -24,7 +24,8 @@ SR71Vessel::SR71Vessel(OBJHANDLE hvessel, int flightmodel) :
 	bco::vessel(hvessel, flightmodel),
 	meshVirtualCockpit_(nullptr)
 {
-	AddComponent(&avionics_);
+	AddComponent(&avionics_);		// Decides if the air data is needed this step.
+	AddComponent(&airData_);		// Before the gauges that read it.
 	AddComponent(&airBrake_);
 	AddComponent(&airspeed_);
 	AddComponent(&altimeter_);
@@ -41,13 +42,14 @@ SR71Vessel::SR71Vessel(OBJHANDLE hvessel, int flightmodel) :
 	AddComponent(&navModes_);
 	AddComponent(&oxygenTank_);
 	AddComponent(&propulsion_);
+	AddComponent(&resources_);		// Steps the tanks above.
 	AddComponent(&powerSystem_);
 	AddComponent(&retroEngines_);
 	AddComponent(&lights_);
 
 	AddComponent(&mfdLeft_);
 	AddComponent(&mfdRight_);
-//	AddComponent(&computer_);
+	AddComponent(&computer_);		// Sets the throttle and surfaces the programs hold.
 	AddComponent(&surfaceCtrl_);
 
 	// Fuel cell					// A signal can drive more then one slot
@@ -57,6 +59,9 @@ SR71Vessel::SR71Vessel(OBJHANDLE hvessel, int flightmodel) :
 
 	// RCS
 
+	// Dock status light
+	bco::connect( DockedChangedSignal(),					slotDocked_);
+
 	// ...which in turn drive the HSI course and heading
 	bco::connect( avionics_.SetCourseSignal(),				hsi_.SetCourseSlot());
 	bco::connect( avionics_.SetHeadingSignal(),				hsi_.SetHeadingSlot());
@@ -71,12 +76,14 @@ SR71Vessel::~SR71Vessel()
 
 void SR71Vessel::SetupAerodynamics()
 {
-	// Aerodynamics - see notes in ShipMets file.
+	// Aerodynamics - see notes in AeroModel.h.
+	InitLiftCoeff();
+
 	CreateAirfoil3(
 		LIFT_VERTICAL, 
 		_V(0, 0, -0.3), 
 		VLiftCoeff, 
-		0, 
+		&vertAeroHint_, 
 		VERT_WING_CHORD, 
 		VERT_WING_AREA, 
 		VERT_WING_AR);
@@ -85,7 +92,7 @@ void SR71Vessel::SetupAerodynamics()
 		LIFT_HORIZONTAL, 
 		_V(0, 0, -4), 
 		HLiftCoeff, 
-		0, 
+		&horzAeroHint_, 
 		HORZ_WING_CHORD,
 		HORZ_WING_AREA,
 		HORZ_WING_AR);
@@ -10,6 +10,8 @@
 #include "../bc_orbiter/transform_display.h"
 #include "../bc_orbiter/flat_roll.h"
 #include "../bc_orbiter/generic_tank.h"
+#include "../bc_orbiter/resource_table.h"
+#include "../bc_orbiter/aero_database.h"
 #include "../bc_orbiter/status_display.h"
 
 #include "ShipMets.h"
@@ -63,7 +65,6 @@ public:
 	int						clbkConsumeBufferedKey(DWORD key, bool down, char *kstate);
     virtual void            clbkPostCreation() override;
 
-	void					clbkPostStep(double simt, double simdt, double mjd);
 	
 	bool					clbkLoadPanel2D(int id, PANELHANDLE hPanel, DWORD viewW, DWORD viewH) override;
 	void					clbkLoadStateEx(FILEHANDLE scn, void* vs) override;
@@ -85,7 +86,12 @@ private:
 	// DRAG
 	double					bDrag{ 0.0 };
 
+	// Where the last aero database lookups for this vessel ended, the airfoil contexts.
+	bco::aero_hint			vertAeroHint_;
+	bco::aero_hint			horzAeroHint_;
+
 	PowerSystem				powerSystem_	{ *this };
+	bco::resource_table		resources_;
 	APU						apu_			{ *this, powerSystem_ };
 
 	AirBrake				airBrake_		{ *this, apu_ };
@@ -93,7 +99,8 @@ private:
 	SurfaceController		surfaceCtrl_	{ *this, apu_ };
 
 	Avionics				avionics_		{ *this, powerSystem_ };
-	Airspeed				airspeed_		{ *this, avionics_ };
+	bco::air_data_computer	airData_		{ Airspeed::MaxPress, Airspeed::MAX_MACH, [this]() { return avionics_.IsAeroActive(); } };
+	Airspeed				airspeed_		{ *this, avionics_, airData_ };
 	Altimeter				altimeter_		{ *this, avionics_ };
 	HSI						hsi_			{ *this, avionics_ };
 	NavModes				navModes_		{ *this, avionics_ };
@@ -101,13 +108,14 @@ private:
 	Shutters				shutters_		{ *this };
 	RCSSystem				rcs_			{ *this, powerSystem_ };
 	Lights					lights_			{ *this, powerSystem_ };
-	PropulsionController	propulsion_		{ powerSystem_, *this };
+	PropulsionController	propulsion_		{ powerSystem_, *this, resources_ };
+	control_executive		computer_;
 	Canopy					canopy_			{ powerSystem_, *this };
 	CargoBayController		cargobay_		{ powerSystem_, *this };
 	HoverEngines			hoverEngines_	{ powerSystem_,	*this };
 	RetroEngines			retroEngines_	{ powerSystem_,	*this };
-	HydrogenTank			hydrogenTank_	{ powerSystem_, *this };
-	OxygenTank				oxygenTank_		{ powerSystem_, *this };
+	HydrogenTank			hydrogenTank_	{ powerSystem_, *this, resources_ };
+	OxygenTank				oxygenTank_		{ powerSystem_, *this, resources_ };
 	FuelCell				fuelCell_		{ powerSystem_, *this, oxygenTank_,	hydrogenTank_ };
 	HUD						headsUpDisplay_	{ powerSystem_, *this };
 
@@ -143,5 +151,8 @@ private:
 											0.0361
 										};
 
+	bco::slot<bool>			slotDocked_	{ [&](bool docked) {
+		statusDock_.set_state(docked ? bco::status_display::status::on : bco::status_display::status::off); }
+	};
 };
 
@@ -182,13 +182,6 @@ void SR71Vessel::clbkMFDMode(int mfd, int mode)
 	mfdRight_.OnMfdMode(mfd, mode);
 }
 
-void SR71Vessel::clbkPostStep(double simt, double simdt, double mjd)
-{
-    vessel::clbkPostStep(simt, simdt, mjd);
-
-	statusDock_.set_state( DockingStatus(0) == 1 ? bco::status_display::status::on : bco::status_display::status::off);
-}
-
 void SR71Vessel::clbkPostCreation()
 {
 	vessel::clbkPostCreation();
@@ -1,6 +1,6 @@
 #define STRICT
 #include "windows.h"
-#include "orbitersdk.h"
+#include "Orbitersdk.h"
 #include "SR71rMFD.h"
 
 // ==============================================================
@@ -2,7 +2,7 @@
 // Date: Sat Mar  8 09:45:53 2025
 
 
-#include "orbitersdk.h"
+#include "Orbitersdk.h"
 
 #ifndef __SR71r_H
 #define __SR71r_H
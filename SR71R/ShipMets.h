@@ -15,7 +15,8 @@
 //	along with this program.If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
-#include "orbitersdk.h"
+#include "Orbitersdk.h"
+#include "AeroModel.h"
 
 // kg  -> lbs : (kb  * 2.20462) = lbs
 // lbs -> kg  : (lbs * 0.45359) = kg
@@ -45,19 +46,7 @@ const VECTOR3 ROTDRAG           = _V( 0.20,   0.26,  0.04);		// From DG (for now
 
 const float GEARDOOR_RANGE      = (float)(-90 * RAD);
 
-// Aerodynamics:
-											        // From NASA:
-											        // Wing span 56.60ft -> 17.25m
-												    // Mean chord 37.70ft -> 11.49m
-const double VERT_WING_AREA         = 198.2     ;   // chord * span = 198.2
-const double VERT_WING_AR           =   1.50    ;   // AR 17.25^2 / 198.2  (wingspan^2 / area)
-const double VERT_WING_CHORD        =  11.49    ;   // area / span
-const double VERT_WIND_EFFICIENCY   =   0.7     ;   // A guess.
-
-const double HORZ_WING_AREA         =  12.0     ;   // Rudders * 2
-const double HORZ_WING_AR           =   1.2     ;   // 3.8^2 (height of both rudders) / 12 (area) - treat two rudders as one big wing.
-const double HORZ_WING_CHORD        =   3.15    ;   // area / span
-const double HORZ_WING_EFFICIENCY   =   0.6     ;   // A guess.
+// Aerodynamics: see AeroModel.h
 
 // Consumables:
 
@@ -24,12 +24,16 @@
 */
 
 #include "Orbitersdk.h"
-#include "..\bc_orbiter\pid_altitude.h"
+#include "../bc_orbiter/pid_altitude.h"
 
 #include "IAvionics.h"
 #include "PropulsionController.h"
 #include "SurfaceController.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 
 namespace bco = bc_orbiter;
 //
@@ -70,6 +74,18 @@ struct IVesselControl
     virtual SurfaceController*      GetSurfaceController() const = 0;
 };
 
+/**
+	Sensor values a control program steps on, sampled by control_executive.  'state' is
+	the vessel's flight_state, so a program only fetches the values it reads.  Rates are
+	taken over the time between samples, so they do not depend on the frame rate.
+*/
+struct control_inputs
+{
+	const bco::flight_state*	state{ nullptr };
+	double				keasRate{ 0.0 };		// KEAS per second.
+	double				machRate{ 0.0 };		// Mach per second.
+};
+
 /**
 	Base class for any program that will control the vessel.  All
 	program input and output (control) will come through the IVesselControl
@@ -78,13 +94,15 @@ struct IVesselControl
 	control programs contain the logic of what the program does. For example,
 	the HoldHeading program implements the logic for steering the vessel
 	towards a target heading.
+
+	step is called by control_executive, 'dt' is always the control period.
 */
 struct control_program
 {
     virtual void set_target(double t) = 0;
     virtual void start(bco::vessel& vessel) = 0;
     virtual void stop(bco::vessel& vessel) = 0;
-    virtual void step(bco::vessel& vessel, double simt, double simdt, double mjd) = 0;
+    virtual void step(bco::vessel& vessel, const control_inputs& in, double dt) = 0;
 };
 
 class HoldHeadingProgram : public control_program
@@ -98,13 +116,13 @@ public:
 
 	void set_target(double target) override { target_ = target; }
 
-    void step(bco::vessel& vessel, double simt, double simdt, double mjd) override
+    void step(bco::vessel& vessel, const control_inputs& in, double dt) override
     {
 		// GetHeading will return a value between 0 and PI2 (0 - 360 in degrees)
-        auto currentYaw     = vessel.get_heading();
+        auto currentYaw     = in.state->yaw();
 
 		// Bank will return between -PI2 to PI2
-        auto currentBank    = vessel.get_bank();
+        auto currentBank    = in.state->bank();
 
         // Find the delta heading from target.  This is also called the 'error'.
 		// When the target is to the left of current, the error is negative.  The
@@ -194,12 +212,12 @@ public:
 
 	void set_target(double t) override { target_ = t; }
 
-    void step(bco::vessel& vessel, double simt, double simdt, double mjd) override
+    void step(bco::vessel& vessel, const control_inputs& in, double dt) override
     {
-        auto currentAltitude = vessel.get_altitude();
+        auto currentAltitude = in.state->altitude();
         auto altError = target_ - currentAltitude;
 
-        auto vertSpeed = vessel.get_vertical_speed();
+        auto vertSpeed = in.state->vertical_speed_fpm();
 
         auto targetClimb = 0.0;
 
@@ -243,7 +261,6 @@ public:
 
 class HoldKeasProgram : public control_program
 {
-    double prevAtmoKeas_{ 0.0 };
     double target_{ 0.0 };
 
 public:
@@ -252,24 +269,18 @@ public:
 
 	void set_target(double t) override { target_ = t; }
 
-    void step(bco::vessel& vessel, double simt, double simdt, double mjd) override
+    void step(bco::vessel& vessel, const control_inputs& in, double dt) override
     {
-        auto currentKeas    = vessel.get_keas();
+        auto currentKeas    = in.state->keas();
         auto thLevel        = vessel.get_main_thrust_level();
 
-        auto accel          = (currentKeas - prevAtmoKeas_) / simdt;
-        prevAtmoKeas_       = currentKeas;
-
         auto dspd           = target_ - currentKeas;
-        auto dThrot         = (dspd - accel) * simdt;
+        auto dThrot         = (dspd - in.keasRate) * dt;
 
         vessel.set_main_thrust_level(thLevel + dThrot);
     }
 
-    void stop(bco::vessel& vessel) override
-    {
-        prevAtmoKeas_ = -1.0;
-    }
+    void stop(bco::vessel& vessel) override {}
 
 	void start(bco::vessel& vessel) override
 	{
@@ -279,7 +290,6 @@ public:
 
 class HoldMachProgram : public control_program
 {
-    double prevAtmoMach_{ 0.0 };
 	double target_{ 0.0 };
 
 public:
@@ -288,26 +298,19 @@ public:
 
 	void set_target(double t) override { target_ = t; }
 
-    void step(bco::vessel& vessel, double simt, double simdt, double mjd) override
+    void step(bco::vessel& vessel, const control_inputs& in, double dt) override
     {
-        double mach         = vessel.get_mach();
-        
         auto thLevel        = vessel.get_main_thrust_level();
 
-        auto currentMach    = mach;
-        auto accel          = (currentMach - prevAtmoMach_) / simdt;
-        prevAtmoMach_       = currentMach;
+        auto currentMach    = in.state->mach();
 
 		auto dspd			= target_ -currentMach;
-        auto dThrot         = (dspd - accel) * simdt;
+        auto dThrot         = (dspd - in.machRate) * dt;
 
         vessel.set_main_thrust_level(thLevel + dThrot);
     }
 
-    void stop(bco::vessel& vessel) override
-    {
-        prevAtmoMach_ = -1.0;
-    }
+    void stop(bco::vessel& vessel) override {}
 
 	void start(bco::vessel& vessel) override
 	{
@@ -329,7 +332,7 @@ public:
 
 	void set_target(double t) override { targetAOA_ = t; }
 
-    void step(bco::vessel& vessel, double simt, double simdt, double mjd) override
+    void step(bco::vessel& vessel, const control_inputs& in, double dt) override
     {
         // Pitch range is between 90 (up) and -90 (down).  A positive pitch rate
         // pitches up, and a negative rate down unless we are upside down (abs(bank) > 90),
@@ -337,7 +340,7 @@ public:
 
         // Start by finding the error (eP) by subtracting the actual from the 
         // target pitch.
-        auto pitch = vessel.get_pitch();
+        auto pitch = in.state->pitch();
         auto eP = targetAOA_ - pitch;
 
         // Example: target = -10, actual = -20:  -10 - -20 = eP of 10.
@@ -347,7 +350,7 @@ public:
 
         // We should never get a value outside of abs(180) so we don't need to 
         // check for rollover errors.
-        auto bank = vessel.get_bank();
+        auto bank = in.state->bank();
 
         // Determine if we are 'up' which is bank < 90.
         auto updn = (fabs(bank) < (90 * RAD)) ? 1 : -1;
@@ -371,8 +374,7 @@ public:
         // Adjust the rate for 'down'.
         tRate = tRate * updn;
 
-        VECTOR3 v;
-        vessel.get_angular_velocity(v);
+        auto& v = in.state->angular_vel();
 
         // Find the rate error.
         auto eRate = tRate - v.x;
@@ -390,6 +392,142 @@ public:
     }
 };
 
+/**
+	Runs the active control programs at a fixed rate from the frame loop.  Frame time is
+	accumulated and every whole control period runs one step of each running program with
+	dt = PERIOD.  At high frame rates most frames do nothing.  The sensors only change
+	between frames, so they are sampled once, into control_inputs, on a frame that steps.
+
+	A frame runs at most MAX_STEPS steps, so the programs cover at most MAX_STEPS * PERIOD
+	(80 ms) of sim time per frame.  Below 12.5 fps, or under time warp, the rest is dropped
+	rather than caught up, the programs fall behind sim time and act more slowly.  The
+	part period left over always carries to the next frame.
+*/
+class control_executive :
+	  public bco::vessel_component
+	, public bco::post_step
+{
+public:
+	static constexpr double RATE_HZ		= 50.0;
+	static constexpr double PERIOD		= 1.0 / RATE_HZ;
+	static constexpr int	MAX_STEPS	= 4;
+
+	control_executive()
+	{
+		programs_.push_back({ FCProgFlags::HoldHeading,		&prgHoldHeading_ });
+		programs_.push_back({ FCProgFlags::HoldAltitude,	&prgHoldAltitude_ });
+		programs_.push_back({ FCProgFlags::HoldKEAS,		&prgHoldKeas_ });
+		programs_.push_back({ FCProgFlags::HoldMACH,		&prgHoldMach_ });
+		programs_.push_back({ FCProgFlags::HoldAttitude,	&prgHoldAttitude_ });
+	}
+
+	FCProgFlags RunningPrograms() const { return running_; }
+
+	bool IsRunning(FCProgFlags pid) const { return (running_ & pid) == pid; }
+
+	/**
+	Starts the programs newly set in 'flags' and stops the ones cleared.
+	*/
+	void SetRunning(bco::vessel& vessel, FCProgFlags flags)
+	{
+		if (running_ == FCProgFlags::None) {
+			accumulated_ = 0.0;
+			hasSample_ = false;
+		}
+
+		for (auto& p : programs_) {
+			auto was = (running_ & p.id) != FCProgFlags::None;
+			auto now = (flags & p.id) != FCProgFlags::None;
+			if (now && !was) p.program->start(vessel);
+			if (was && !now) p.program->stop(vessel);
+		}
+
+		running_ = flags;
+	}
+
+	void ToggleProgram(bco::vessel& vessel, FCProgFlags pid)
+	{
+		SetRunning(vessel, IsRunning(pid) ? (running_ & ~pid) : (running_ | pid));
+	}
+
+	void SetTarget(FCProgFlags pid, double target)
+	{
+		for (auto& p : programs_) {
+			if (p.id == pid) p.program->set_target(target);
+		}
+	}
+
+	// post_step
+	void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override
+	{
+		if (running_ == FCProgFlags::None) return;
+
+		accumulated_ += simdt;
+		auto steps = static_cast<int>(floor(accumulated_ / PERIOD));
+		if (steps < 1) return;
+
+		if (steps > MAX_STEPS) {
+			steps = MAX_STEPS;
+			accumulated_ = fmod(accumulated_, PERIOD);		// Drop the backlog, keep the phase.
+		}
+		else {
+			accumulated_ -= steps * PERIOD;
+		}
+
+		Sample(vessel, simt);
+		for (int i = 0; i < steps; i++) {
+			for (auto& p : programs_) {
+				if ((running_ & p.id) != FCProgFlags::None) p.program->step(vessel, inputs_, PERIOD);
+			}
+		}
+	}
+
+private:
+	struct entry {
+		FCProgFlags			id;
+		control_program*	program;
+	};
+
+	void Sample(bco::vessel& vessel, double simt)
+	{
+		auto& fs = vessel.GetFlightState();
+		auto elapsed = simt - sampleTime_;
+		auto keas = fs.keas();
+		auto mach = fs.mach();
+
+		if (hasSample_ && (elapsed > 0.0)) {
+			inputs_.keasRate = (keas - lastKeas_) / elapsed;
+			inputs_.machRate = (mach - lastMach_) / elapsed;
+		}
+		else {
+			inputs_.keasRate = 0.0;
+			inputs_.machRate = 0.0;
+		}
+
+		inputs_.state = &fs;
+		lastKeas_ = keas;
+		lastMach_ = mach;
+		sampleTime_ = simt;
+		hasSample_ = true;
+	}
+
+	HoldHeadingProgram		prgHoldHeading_;
+	HoldAltitudeProgram		prgHoldAltitude_;
+	HoldKeasProgram			prgHoldKeas_;
+	HoldMachProgram			prgHoldMach_;
+	HoldAttitude			prgHoldAttitude_;
+
+	std::vector<entry>		programs_;
+	FCProgFlags				running_{ FCProgFlags::None };
+
+	control_inputs			inputs_;
+	double					accumulated_{ 0.0 };
+	double					sampleTime_{ 0.0 };
+	double					lastKeas_{ 0.0 };
+	double					lastMach_{ 0.0 };
+	bool					hasSample_{ false };
+};
+
 /**
     VesselControl provides a control interface between the low level
     vessel control calls and the various classes that automate vessel
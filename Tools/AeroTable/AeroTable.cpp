@@ -0,0 +1,559 @@
+//	AeroTable - SR-71r Orbiter Addon
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Builds an aero database (Config\Vessels\SR71r_aero.csv) from the built in aero model, checks a
+// database against it, and checks and sweeps the airfoil callbacks themselves (LiftCoeff.cpp,
+// compiled in) for speed and numeric regressions.  A database sampled from the model is less
+// accurate than the model's own tables, so none is shipped, the format is for measured data.
+// Built against the SDK stand-in in Tools/OrbiterStub:
+//
+//	g++ -std=c++20 -O2 -pthread -I../OrbiterStub -I../../bc_orbiter -I../../SR71R AeroTable.cpp ../../SR71R/LiftCoeff.cpp -o AeroTable
+//	cl /std:c++20 /O2 /EHsc /I..\OrbiterStub /I..\..\bc_orbiter /I..\..\SR71R AeroTable.cpp ..\..\SR71R\LiftCoeff.cpp
+//
+//	AeroTable > SR71r_aero.csv					Write the database.
+//	AeroTable --check SR71r_aero.csv			Load a database and report its error against the model.
+//	AeroTable --callbacks						VLiftCoeff/HLiftCoeff: the built in fallback (no database, a bad
+//												one, one missing an airfoil) must give exactly the built in
+//												tables, a loaded database exactly its grids, and the airfoil
+//												context hint must not change a result.
+//	AeroTable --accuracy						The built in callbacks against the original scanning ones over
+//												the dense sweep, and ns per call each.  Fails if any
+//												coefficient is off by more than 1e-4.  Both sides use the
+//												stub's drag functions, so this checks the sampling, not
+//												Orbiter's own drag.
+//	AeroTable --sweep [db] [threads]			Evaluations per second over a dense aoa/beta x mach sweep,
+//												run again on 'threads' threads, which must give the same results.
+//	AeroTable --golden [db] > golden.csv		Write the callback results over the sweep (built in, and db if given).
+//	AeroTable --compare golden.csv [db]			Compare against a golden file, fails on any difference
+//												over 1e-12.  Write it before changing the lookups and compare after.
+
+#include "Orbitersdk.h"
+
+#include "AeroModel.h"
+#include "LiftCoeff.h"
+#include "aero_database.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace bco = bc_orbiter;
+
+namespace {
+	using AirfoilCoeff = void (*)(VESSEL*, double, double, double, void*, double*, double*, double*);
+
+	// Finer where the model bends: around the wing breakpoints and just past mach 1.1.
+	bco::aero_axis VerticalAoa()
+	{
+		std::vector<double> p;
+		for (int d = -180; d <= 180; d += ((d >= -60) && (d < 60)) ? 1 : 5) p.push_back(d * RAD);
+		return bco::aero_axis(p);
+	}
+
+	bco::aero_axis HorizontalBeta()
+	{
+		std::vector<double> p;
+		for (int d = -180; d <= 180; d += 5) p.push_back(d * RAD);
+		return bco::aero_axis(p);
+	}
+
+	bco::aero_axis Mach()
+	{
+		return bco::aero_axis({ 0.0, 0.75, 1.0, 1.1, 1.12, 1.15, 1.2, 1.25, 1.3, 1.4, 1.5, 1.6, 1.8, 2.0,
+			2.5, 3.0, 4.0, 5.0, 6.0, 8.0, 10.0, 15.0, 20.0, 30.0 });
+	}
+
+	bco::aero_coeff VerticalModel(double aoa, double M)
+	{
+		bco::aero_coeff c;
+		aero_model::Vertical(aoa, c.cl, c.cm, c.cd);
+		c.cd += aero_model::WaveDrag(M);
+		return c;
+	}
+
+	bco::aero_coeff HorizontalModel(double beta, double M)
+	{
+		bco::aero_coeff c;
+		aero_model::Horizontal(beta, c.cl, c.cd);
+		c.cd += aero_model::WaveDrag(M);
+		return c;
+	}
+
+	bool Load(const char* path, bco::aero_database& db)
+	{
+		std::ifstream in(path);
+		std::string error;
+		if (!in || !db.load(in, error)) {
+			fprintf(stderr, "%s: %s\n", path, in ? error.c_str() : "cannot open");
+			return false;
+		}
+
+		if (!db.find("vertical") || !db.find("horizontal")) {
+			fprintf(stderr, "%s: needs 'vertical' and 'horizontal' airfoils\n", path);
+			return false;
+		}
+		return true;
+	}
+
+	template<typename F>
+	void Check(const bco::aero_grid& grid, F model)
+	{
+		std::mt19937 gen(71);
+		std::uniform_real_distribution<double> aoa(-180 * RAD, 180 * RAD);
+		std::uniform_real_distribution<double> mach(0.0, 30.0);
+
+		bco::aero_hint hint;
+		bco::aero_coeff worst;
+		for (int i = 0; i < 1000000; i++) {
+			auto a = aoa(gen);
+			auto m = mach(gen);
+			auto g = grid.evaluate(a, m, hint);
+			auto r = model(a, m);
+			worst.cl = fmax(worst.cl, fabs(g.cl - r.cl));
+			worst.cm = fmax(worst.cm, fabs(g.cm - r.cm));
+			worst.cd = fmax(worst.cd, fabs(g.cd - r.cd));
+		}
+
+		printf("%-10s %4zu aoa x %2zu mach  max abs error cl %.2e cm %.2e cd %.2e\n",
+			grid.name().c_str(), grid.aoa().size(), grid.mach().size(), worst.cl, worst.cm, worst.cd);
+	}
+
+	// The airfoil callbacks (LiftCoeff.cpp) with the built in model, and with the database when given.
+	// 'database' is loaded into LiftCoeff.cpp before the source is evaluated, see Use.
+	struct Source {
+		std::string		name;
+		const char*		database;
+		AirfoilCoeff	callback;
+
+		bco::aero_coeff eval(double a, double m, bco::aero_hint& hint) const
+		{
+			bco::aero_coeff c;
+			callback(nullptr, a, m, 0.0, &hint, &c.cl, &c.cm, &c.cd);
+			return c;
+		}
+	};
+
+	void Use(const Source& source)
+	{
+		if (!LoadLiftCoeff(source.database) && (source.database != nullptr)) {
+			fprintf(stderr, "%s\n", orbiter_stub::lastLog.c_str());
+			exit(1);
+		}
+	}
+
+	std::vector<Source> Sources(const char* dbPath)
+	{
+		std::vector<Source> sources{
+			{ "builtin vertical", nullptr, VLiftCoeff },
+			{ "builtin horizontal", nullptr, HLiftCoeff }
+		};
+
+		if (dbPath != nullptr) {
+			sources.push_back({ "database vertical", dbPath, VLiftCoeff });
+			sources.push_back({ "database horizontal", dbPath, HLiftCoeff });
+		}
+		return sources;
+	}
+
+	// Dense sweep: every 0.1 deg from -180 to 180, mach 0 to 25 every 0.05, mach in the outer loop
+	// the way a flight moves through it.
+	const int SWEEP_AOA = 3601;
+	const int SWEEP_MACH = 501;
+
+	double SweepAoa(int i) { return (-180.0 + i * 0.1) * RAD; }
+	double SweepMach(int j) { return j * 0.05; }
+
+	double Sweep(const Source& source)
+	{
+		bco::aero_hint hint;
+		double sum = 0.0;
+		for (int j = 0; j < SWEEP_MACH; j++) {
+			for (int i = 0; i < SWEEP_AOA; i++) {
+				auto c = source.eval(SweepAoa(i), SweepMach(j), hint);
+				sum += c.cl + c.cm + c.cd;
+			}
+		}
+		return sum;
+	}
+
+	int RunSweep(const std::vector<Source>& sources, int threads)
+	{
+		auto evals = double(SWEEP_AOA) * SWEEP_MACH;
+		auto failed = false;
+
+		for (auto& source : sources) {
+			Use(source);
+			auto start = std::chrono::steady_clock::now();
+			auto expected = Sweep(source);
+			std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+			// Every thread sweeps with its own hint over the shared tables.
+			std::vector<double> sums(threads);
+			std::vector<std::thread> pool;
+			start = std::chrono::steady_clock::now();
+			for (int t = 0; t < threads; t++) {
+				pool.emplace_back([&, t]() { sums[t] = Sweep(source); });
+			}
+			for (auto& th : pool) th.join();
+			std::chrono::duration<double> mtSecs = std::chrono::steady_clock::now() - start;
+
+			auto same = true;
+			for (auto s : sums) same = same && (s == expected);
+			failed = failed || !same;
+
+			printf("%-20s %7.1f M evals/s   %d threads %7.1f M evals/s  %s\n", source.name.c_str(),
+				evals / secs.count() / 1e6, threads, evals * threads / mtSecs.count() / 1e6,
+				same ? "same results" : "RESULTS DIFFER");
+		}
+		return failed ? 1 : 0;
+	}
+
+	// The airfoil callbacks as they were before the tables, borrowed from DeltaGlider.
+	void ScanVertical(double aoa, double M, double& cl, double& cm, double& cd)
+	{
+		int i;
+		const int nabsc = 9;
+		static const double AOA[nabsc] = { -180 * RAD, -60 * RAD, -30 * RAD, -2 * RAD, 15 * RAD, 20 * RAD, 25 * RAD, 60 * RAD, 180 * RAD };
+		static const double CL[nabsc] = { 0, 0, -0.4, 0, 0.7, 1, 0.8, 0, 0 };
+		static const double CM[nabsc] = { 0, 0, 0.014, 0.0039, -0.006, -0.008, -0.010, 0, 0 };
+		for (i = 0; i < nabsc - 1 && AOA[i + 1] < aoa; i++);
+		double f = (aoa - AOA[i]) / (AOA[i + 1] - AOA[i]);
+		cl = CL[i] + (CL[i + 1] - CL[i]) * f;
+		cm = CM[i] + (CM[i + 1] - CM[i]) * f;
+		double saoa = sin(aoa);
+		double pd = 0.015 + 0.4*saoa*saoa;
+		cd = pd + oapiGetInducedDrag(cl, VERT_WING_AR, VERT_WIND_EFFICIENCY) + oapiGetWaveDrag(M, 0.75, 1.0, 1.1, 0.04);
+	}
+
+	void ScanHorizontal(double beta, double M, double& cl, double& cm, double& cd)
+	{
+		int i;
+		const int nabsc = 8;
+		static const double BETA[nabsc] = { -180 * RAD, -135 * RAD, -90 * RAD, -45 * RAD, 45 * RAD, 90 * RAD, 135 * RAD, 180 * RAD };
+		static const double CL[nabsc] = { 0, +0.3, 0, -0.3, +0.3, 0, -0.3, 0 };
+		for (i = 0; i < nabsc - 1 && BETA[i + 1] < beta; i++);
+		cl = CL[i] + (CL[i + 1] - CL[i]) * (beta - BETA[i]) / (BETA[i + 1] - BETA[i]);
+		cm = 0.0;
+		cd = 0.015 + oapiGetInducedDrag(cl, HORZ_WING_AR, HORZ_WING_EFFICIENCY) + oapiGetWaveDrag(M, 0.75, 1.0, 1.1, 0.04);
+	}
+
+	using Scan = void (*)(double, double, double&, double&, double&);
+
+	// Largest difference of the built in callbacks from the scans over the dense sweep, and the time
+	// per call of each.
+	int Accuracy()
+	{
+		const double TOLERANCE = 1e-4;
+		const double evals = double(SWEEP_AOA) * SWEEP_MACH;
+
+		struct Pair {
+			const char*		name;
+			Scan			scan;
+			AirfoilCoeff	callback;
+		};
+		const Pair pairs[] = {
+			{ "vertical", ScanVertical, VLiftCoeff },
+			{ "horizontal", ScanHorizontal, HLiftCoeff }
+		};
+
+		LoadLiftCoeff(nullptr);
+
+		auto failed = false;
+		for (auto& p : pairs) {
+			auto table = [&p](double a, double m, double& cl, double& cm, double& cd) { p.callback(nullptr, a, m, 0.0, nullptr, &cl, &cm, &cd); };
+
+			bco::aero_coeff worst;
+			for (int j = 0; j < SWEEP_MACH; j++) {
+				for (int i = 0; i < SWEEP_AOA; i++) {
+					bco::aero_coeff s, t;
+					p.scan(SweepAoa(i), SweepMach(j), s.cl, s.cm, s.cd);
+					table(SweepAoa(i), SweepMach(j), t.cl, t.cm, t.cd);
+					worst.cl = fmax(worst.cl, fabs(s.cl - t.cl));
+					worst.cm = fmax(worst.cm, fabs(s.cm - t.cm));
+					worst.cd = fmax(worst.cd, fabs(s.cd - t.cd));
+				}
+			}
+
+			auto time = [&](auto f) {
+				double sum = 0.0;
+				auto start = std::chrono::steady_clock::now();
+				for (int j = 0; j < SWEEP_MACH; j++) {
+					for (int i = 0; i < SWEEP_AOA; i++) {
+						double cl, cm, cd;
+						f(SweepAoa(i), SweepMach(j), cl, cm, cd);
+						sum += cl + cm + cd;
+					}
+				}
+				std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+				return (sum == 0.0) ? 0.0 : ns.count() / evals;		// Uses the sum so the loop is kept.
+			};
+
+			auto bad = (worst.cl > TOLERANCE) || (worst.cm > TOLERANCE) || (worst.cd > TOLERANCE);
+			failed = failed || bad;
+			printf("%-10s max abs error cl %.2e cm %.2e cd %.2e%s   scan %5.1f ns  table %5.1f ns per call\n", p.name,
+				worst.cl, worst.cm, worst.cd, bad ? "  FAIL" : "", time(p.scan), time(table));
+		}
+		return failed ? 1 : 0;
+	}
+
+	bco::aero_database BuildDatabase()
+	{
+		bco::aero_database db;
+		db.add(bco::aero_grid("vertical", VerticalAoa(), Mach(), VerticalModel));
+		db.add(bco::aero_grid("horizontal", HorizontalBeta(), Mach(), HorizontalModel));
+		return db;
+	}
+
+	/**
+	Callbacks
+	Loads databases into LiftCoeff.cpp through a scratch file and checks what VLiftCoeff and HLiftCoeff
+	return over the golden grid, called with a hint carried from call to call, as Orbiter does with
+	the airfoil context, and with a null context.
+	*/
+	int Callbacks()
+	{
+		const char* SCRATCH = "AeroTable_callbacks.csv";
+		aero_model::Tables tables;
+		tables.build(oapiGetInducedDrag, oapiGetWaveDrag);
+		auto failed = false;
+
+		auto write = [&](const char* text, bool horizontal) {
+			std::ofstream out(SCRATCH);
+			out << text;
+			auto db = BuildDatabase();
+			bco::aero_database some;
+			some.add(*db.find("vertical"));
+			(horizontal ? db : some).save(out);
+		};
+
+		// Every result of both callbacks must be bit for bit 'expected'.
+		auto expect = [&](const char* name, auto expected) {
+			const AirfoilCoeff callbacks[] = { VLiftCoeff, HLiftCoeff };
+			size_t bad = 0;
+			for (int v = 0; v < 2; v++) {
+				bco::aero_hint hint;
+				for (int j = 0; j < SWEEP_MACH; j += 5) {
+					for (int i = 0; i < SWEEP_AOA; i += 10) {
+						auto a = SweepAoa(i);
+						auto m = SweepMach(j);
+						bco::aero_coeff h, n;
+						callbacks[v](nullptr, a, m, 0.0, &hint, &h.cl, &h.cm, &h.cd);
+						callbacks[v](nullptr, a, m, 0.0, nullptr, &n.cl, &n.cm, &n.cd);
+						auto e = expected(v == 0, a, m);
+						if ((memcmp(&h, &e, sizeof(e)) != 0) || (memcmp(&n, &e, sizeof(e)) != 0)) bad++;
+					}
+				}
+			}
+			printf("  %-40s %s\n", name, (bad == 0) ? "ok" : "FAIL");
+			if (bad != 0) fprintf(stderr, "%s: %zu results differ\n", name, bad);
+			failed |= (bad != 0);
+		};
+
+		auto builtin = [&](bool vertical, double a, double m) {
+			bco::aero_coeff c;
+			if (vertical) tables.Vertical(a, m, c.cl, c.cm, c.cd);
+			else tables.Horizontal(a, m, c.cl, c.cm, c.cd);
+			return c;
+		};
+
+		// Falls back with a log line naming the reason.
+		auto fallback = [&](const char* name, const char* path, const char* reason) {
+			orbiter_stub::lastLog.clear();
+			auto loaded = LoadLiftCoeff(path);
+			auto logged = (path == nullptr) || (orbiter_stub::lastLog.find(reason) != std::string::npos);
+			if (loaded || !logged) {
+				fprintf(stderr, "%s: %s, log '%s'\n", name, loaded ? "loaded" : "reason not logged", orbiter_stub::lastLog.c_str());
+				failed = true;
+			}
+			expect(name, builtin);
+		};
+
+		printf("Airfoil callbacks:\n");
+		fallback("no database, built in", nullptr, "");
+		remove(SCRATCH);
+		fallback("database missing, built in", SCRATCH, "not found");
+
+		write("not a database\n", true);
+		fallback("bad database, built in", SCRATCH, "built in aero model");
+
+		write("", false);
+		fallback("no horizontal airfoil, built in", SCRATCH, "needs 'vertical' and 'horizontal'");
+
+		write("", true);
+		if (!LoadLiftCoeff(SCRATCH)) {
+			fprintf(stderr, "database did not load: %s\n", orbiter_stub::lastLog.c_str());
+			failed = true;
+		}
+		bco::aero_database db;
+		failed |= !Load(SCRATCH, db);
+		expect("database, its grids", [&](bool vertical, double a, double m) {
+			bco::aero_hint hint;
+			return db.find(vertical ? "vertical" : "horizontal")->evaluate(a, m, hint);
+		});
+
+		// The context is where the grid keeps its place: it must be written through.
+		bco::aero_hint hint;
+		double cl, cm, cd;
+		VLiftCoeff(nullptr, 10 * RAD, 2.0, 0.0, &hint, &cl, &cm, &cd);
+		auto used = (hint.aoa != 0) && (hint.mach != 0);
+		printf("  %-40s %s\n", "context hint updated", used ? "ok" : "FAIL");
+		failed |= !used;
+
+		LoadLiftCoeff(nullptr);
+		remove(SCRATCH);
+		return failed ? 1 : 0;
+	}
+
+	// Golden rows are the sweep every 1 deg and 0.25 mach.
+	template<typename F>
+	void ForGolden(const std::vector<Source>& sources, F func)
+	{
+		for (auto& source : sources) {
+			Use(source);
+			bco::aero_hint hint;
+			for (int j = 0; j < SWEEP_MACH; j += 5) {
+				for (int i = 0; i < SWEEP_AOA; i += 10) {
+					func(source, SweepMach(j), SweepAoa(i), source.eval(SweepAoa(i), SweepMach(j), hint));
+				}
+			}
+		}
+	}
+
+	void WriteGolden(const std::vector<Source>& sources)
+	{
+		printf("# source, mach, aoa(rad), cl, cm, cd\n");
+		ForGolden(sources, [](const Source& s, double m, double a, const bco::aero_coeff& c) {
+			printf("%s, %.17g, %.17g, %.17g, %.17g, %.17g\n", s.name.c_str(), m, a, c.cl, c.cm, c.cd);
+		});
+	}
+
+	int Compare(const char* path, const std::vector<Source>& sources)
+	{
+		std::ifstream in(path);
+		if (!in) {
+			fprintf(stderr, "%s: cannot open\n", path);
+			return 1;
+		}
+
+		const double TOLERANCE = 1e-12;
+		std::string line;
+		size_t rows = 0, bad = 0;
+		double worst = 0.0;
+		auto ok = true;
+
+		ForGolden(sources, [&](const Source& s, double m, double a, const bco::aero_coeff& c) {
+			if (!ok) return;
+			while (std::getline(in, line) && (line.empty() || (line[0] == '#')));
+
+			auto comma = line.find(',');
+			std::istringstream fields(line.substr(comma + 1));
+			char sep;
+			double gm, ga;
+			bco::aero_coeff g;
+			if ((comma == std::string::npos) || (line.substr(0, comma) != s.name) ||
+				!(fields >> gm >> sep >> ga >> sep >> g.cl >> sep >> g.cm >> sep >> g.cd) || (gm != m) || (ga != a)) {
+				fprintf(stderr, "%s: row %zu does not match the sweep (%s), regenerate it with the same sources\n",
+					path, rows + 1, s.name.c_str());
+				ok = false;
+				return;
+			}
+
+			auto diff = fmax(fabs(c.cl - g.cl), fmax(fabs(c.cm - g.cm), fabs(c.cd - g.cd)));
+			worst = fmax(worst, diff);
+			if (diff > TOLERANCE) {
+				if (bad++ < 10) fprintf(stderr, "%s mach %g aoa %g deg: differs by %.3e\n", s.name.c_str(), m, a / RAD, diff);
+			}
+			rows++;
+		});
+
+		if (!ok) return 1;
+		while (std::getline(in, line)) {
+			if (!line.empty() && (line[0] != '#')) {
+				fprintf(stderr, "%s: has rows past the sweep, regenerate it with the same sources\n", path);
+				return 1;
+			}
+		}
+
+		printf("%zu rows, %zu over %.0e, max difference %.3e\n", rows, bad, TOLERANCE, worst);
+		return (bad == 0) ? 0 : 1;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto is = [&](const char* option) { return (argc >= 2) && (strcmp(argv[1], option) == 0); };
+	InitLiftCoeff();		// Builds the built in tables, here from the stub's drag functions.
+
+	if (is("--check") && (argc == 3)) {
+		bco::aero_database db;
+		if (!Load(argv[2], db)) return 1;
+
+		Check(*db.find("vertical"), VerticalModel);
+		Check(*db.find("horizontal"), HorizontalModel);
+		return 0;
+	}
+
+	if (is("--callbacks") && (argc == 2)) return Callbacks();
+	if (is("--accuracy") && (argc == 2)) return Accuracy();
+
+	if (is("--sweep") || is("--golden") || is("--compare")) {
+		auto first = is("--compare") ? 3 : 2;
+		const char* dbPath = nullptr;
+		int threads = std::max(2u, std::thread::hardware_concurrency());
+		for (int i = first; i < argc; i++) {
+			if (isdigit(static_cast<unsigned char>(argv[i][0]))) threads = atoi(argv[i]);
+			else dbPath = argv[i];
+		}
+
+		bco::aero_database db;
+		if ((dbPath != nullptr) && !Load(dbPath, db)) return 1;
+
+		auto sources = Sources(dbPath);
+
+		if (is("--sweep")) return RunSweep(sources, threads);
+		if (is("--golden")) {
+			WriteGolden(sources);
+			return 0;
+		}
+		if (argc >= 3) return Compare(argv[2], sources);
+	}
+
+	if (argc != 1) {
+		fprintf(stderr, "usage: AeroTable > SR71r_aero.csv\n"
+						"       AeroTable --check SR71r_aero.csv\n"
+						"       AeroTable --callbacks\n"
+						"       AeroTable --accuracy\n"
+						"       AeroTable --sweep [db] [threads]\n"
+						"       AeroTable --golden [db] > golden.csv\n"
+						"       AeroTable --compare golden.csv [db]\n");
+		return 1;
+	}
+
+	auto db = BuildDatabase();
+
+	std::cout << "# SR-71r aero database, written by Tools\\AeroTable from the built in model (AeroModel.h).\n"
+			  << "# Edit freely: rows of an airfoil need only cover a full aoa x mach grid.\n";
+	db.save(std::cout);
+	return 0;
+}
@@ -0,0 +1,292 @@
+//	AirDataCheck - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Checks air_data_computer (air_data_computer.h) against what the airspeed gauge worked out
+// itself before, GetVesselKias, GetVesselKeas (Tools.h) and the max mach and log scale sums, over
+// a mach x altitude grid in two atmospheres.  Then times the air data on its own, and a full
+// avionics frame (Avionics, Airspeed, Altimeter and HSI together), the old way with each gauge
+// calling Orbiter itself and the new way through the flight_state.  Built against the SDK stand-in
+// in Tools/OrbiterStub:
+//
+//	g++ -std=c++20 -O2 -I../OrbiterStub -I../../bc_orbiter AirDataCheck.cpp -o AirDataCheck
+//	cl /std:c++20 /O2 /EHsc /I..\OrbiterStub /I..\..\bc_orbiter AirDataCheck.cpp
+//
+//	AirDataCheck			Largest difference of each value, then time and Orbiter calls per frame each
+//							way.  Exits 1 if any value differs by more than 1e-12 relative and 1e-9
+//							absolute, the new way makes more calls than the old, or the avionics frame
+//							takes longer through the flight_state.  KIAS near zero, at very low
+//							pressure, loses digits to cancellation either way.
+
+#include "air_data_computer.h"
+#include "vessel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	const double MAX_PRESS = 60000.0;		// Airspeed::MaxPress
+	const double MAX_MACH = 22.0;			// Airspeed::MAX_MACH
+
+	/**
+	legacy_air_data
+	The air data sums as Airspeed::handle_post_step did them before air_data_computer.
+	*/
+	struct legacy_air_data :
+		  public bco::vessel_component
+		, public bco::post_step
+	{
+		double	keas{ 0.0 };
+		double	kias{ 0.0 };
+		double	mach{ 0.0 };
+		double	maxMach{ 0.0 };
+		double	machRatio{ 0.0 };
+		double	maxMachRatio{ 0.0 };
+
+		void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override {
+			const double l22 = log(MAX_MACH + 1);
+
+			keas = bco::GetVesselKeas(&vessel);
+			kias = bco::GetVesselKias(&vessel);
+			mach = vessel.GetMachNumber();
+			maxMach = 0.0;
+
+			auto atmDens = vessel.GetAtmDensity();
+			if (atmDens > 0.0) maxMach = sqrt(MAX_PRESS / atmDens) / 331.34;
+
+			auto machGauge = (mach > MAX_MACH) ? MAX_MACH : mach;
+			auto pinned = std::clamp(maxMach, 0.0, MAX_MACH);
+			maxMachRatio = (pinned == 0.0) ? 0.0 : log(pinned + 1) / l22;
+			machRatio = log(machGauge + 1.0) / l22;
+		}
+	};
+
+	// The rest of an avionics frame, as Avionics, Altimeter and HSI read their values before the
+	// flight_state (old) and now (new).  No nav source is tuned, so the HSI reads only the heading.
+	struct legacy_gauges :
+		  public bco::vessel_component
+		, public bco::post_step
+	{
+		double	shown{ 0.0 };
+
+		void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override {
+			int res = 0;
+			shown = vessel.GetAOA() + bco::GetVerticalSpeedFPM(&vessel) + vessel.GetPitch() + vessel.GetBank() + vessel.GetDynPressure()
+				+ vessel.GetAltitude(AltitudeMode::ALTMODE_GROUND, &res)
+				+ vessel.GetYaw();
+		}
+	};
+
+	struct gauges :
+		  public bco::vessel_component
+		, public bco::post_step
+	{
+		bco::air_data_computer&	airData;
+		double	shown{ 0.0 };
+
+		explicit gauges(bco::air_data_computer& a) : airData(a) {}
+
+		void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override {
+			auto& fs = vessel.GetFlightState();
+			shown = fs.aoa() + fs.vertical_speed_fpm() + fs.pitch() + fs.bank() + fs.dyn_pressure()
+				+ fs.altitude_ground()
+				+ fs.yaw();
+
+			// Airspeed, from the air data computer.
+			shown += airData.KeasSignal().current() + airData.KiasSignal().current() + airData.MaxMachRatioSignal().current();
+		}
+	};
+
+	struct bench_vessel : public bco::vessel
+	{
+		bench_vessel() : bco::vessel(nullptr, 1) {}
+	};
+
+	struct atmosphere {
+		const char*	name;
+		double		p0;			// Pa
+		double		rho0;		// kg/m^3
+		double		scale;		// Scale height, m.
+		double		gamma;
+	};
+
+	// Isothermal models, close enough to give realistic pressure and density pairs.
+	const atmosphere atmospheres[] = {
+		{ "earth", 101325.0, 1.225, 8500.0, 1.4 },
+		{ "mars", 610.0, 0.020, 11100.0, 1.29 },
+	};
+
+	struct point {
+		double	mach;
+		double	pressure;
+		double	density;
+	};
+
+	std::vector<point> grid(const atmosphere& a)
+	{
+		std::vector<point> g;
+		for (int h = 0; h <= 120000; h += 500) {
+			auto f = exp(-h / a.scale);
+			for (int m = 0; m <= 500; m++) g.push_back({ m * 0.05, a.p0 * f, a.rho0 * f });
+		}
+		return g;
+	}
+
+	void set(const point& p)
+	{
+		orbiter_stub::values.mach = p.mach;
+		orbiter_stub::values.atmPressure = p.pressure;
+		orbiter_stub::values.atmDensity = p.density;
+	}
+
+	struct difference {
+		double	relative{ 0.0 };
+		double	absolute{ 0.0 };
+		bool	failed{ false };
+
+		void add(double a, double b)
+		{
+			auto d = std::fabs(a - b);
+			auto scale = std::max(std::fabs(a), std::fabs(b));
+			auto r = (scale == 0.0) ? 0.0 : d / scale;
+			relative = std::max(relative, r);
+			absolute = std::max(absolute, d);
+			if ((r > 1e-12) && (d > 1e-9)) failed = true;
+		}
+	};
+}
+
+int main()
+{
+	bench_vessel v;
+	bco::air_data_computer airData(MAX_PRESS, MAX_MACH);
+	legacy_air_data legacy;
+	v.AddComponent(&airData);
+	v.AddComponent(&legacy);
+
+	const char* names[] = { "keas", "kias", "mach", "max mach", "mach ratio", "max mach ratio" };
+	difference worst[6];
+	size_t points = 0;
+	double t = 0.0;
+
+	for (auto& a : atmospheres) {
+		orbiter_stub::atmConstants.gamma = a.gamma;
+		orbiter_stub::values.atmRef = const_cast<atmosphere*>(&a);		// A new reference makes air_data_computer reload gamma.
+
+		for (auto& p : grid(a)) {
+			set(p);
+			t += 0.02;
+			v.clbkPostStep(t, 0.02, 0.0);
+
+			const double got[] = {
+				airData.KeasSignal().current(), airData.KiasSignal().current(), airData.MachSignal().current(),
+				airData.MaxMachSignal().current(), airData.MachRatioSignal().current(), airData.gauge_ratio(airData.MaxMachSignal().current()) };
+			const double want[] = { legacy.keas, legacy.kias, legacy.mach, legacy.maxMach, legacy.machRatio, legacy.maxMachRatio };
+
+			for (int i = 0; i < 6; i++) worst[i].add(got[i], want[i]);
+			points++;
+		}
+	}
+
+	auto failed = false;
+	printf("%zu points, largest difference:\n", points);
+	printf("  %-16s %10s %10s\n", "", "relative", "absolute");
+	for (int i = 0; i < 6; i++) {
+		printf("  %-16s %10.3g %10.3g%s\n", names[i], worst[i].relative, worst[i].absolute, worst[i].failed ? "  FAIL" : "");
+		failed |= worst[i].failed;
+	}
+
+	// Each way on its own vessel, the same vessel overhead in all.  The ways take turns within each
+	// pass over the grid so they see the same machine, best pass of each.
+	struct way {
+		const char*		name;
+		bco::vessel*	vessel;
+		double			best{ 1e30 };
+		size_t			calls{ 0 };
+	};
+
+	bench_vessel bare;
+
+	bench_vessel oldVessel;
+	legacy_air_data oldAirData;
+	oldVessel.AddComponent(&oldAirData);
+
+	bench_vessel newVessel;
+	bco::air_data_computer newAirData(MAX_PRESS, MAX_MACH);
+	newVessel.AddComponent(&newAirData);
+
+	bench_vessel oldFrame;
+	legacy_air_data oldFrameAirData;
+	legacy_gauges oldFrameGauges;
+	oldFrame.AddComponent(&oldFrameAirData);
+	oldFrame.AddComponent(&oldFrameGauges);
+
+	bench_vessel newFrame;
+	bco::air_data_computer newFrameAirData(MAX_PRESS, MAX_MACH);
+	gauges newFrameGauges(newFrameAirData);
+	newFrame.AddComponent(&newFrameAirData);
+	newFrame.AddComponent(&newFrameGauges);
+
+	way ways[] = {
+		{ "vessel only", &bare },
+		{ "air data, gauge sums", &oldVessel },
+		{ "air data, computer", &newVessel },
+		{ "avionics frame, old", &oldFrame },
+		{ "avionics frame, flight_state", &newFrame },
+	};
+
+	auto g = grid(atmospheres[0]);
+	orbiter_stub::atmConstants.gamma = atmospheres[0].gamma;
+	orbiter_stub::values.atmRef = const_cast<atmosphere*>(&atmospheres[0]);
+
+	const int PASSES = 20;
+	for (int pass = 0; pass < PASSES; pass++) {
+		for (auto& w : ways) {
+			auto calls = orbiter_stub::apiCalls;
+			auto start = std::chrono::steady_clock::now();
+			for (auto& p : g) {
+				set(p);
+				orbiter_stub::values.pitch = p.mach * 0.01;		// Attitude moves too.
+				t += 0.02;
+				w.vessel->clbkPostStep(t, 0.02, 0.0);
+			}
+			std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+			w.best = std::min(w.best, ns.count() / g.size());
+			w.calls = orbiter_stub::apiCalls - calls;
+		}
+	}
+
+	printf("Frame time:\n");
+	for (auto& w : ways) {
+		printf("  %-30s %8.1f ns %6.1f API calls per frame\n", w.name, w.best, static_cast<double>(w.calls) / g.size());
+	}
+
+	if ((ways[2].calls > ways[1].calls) || (ways[4].calls > ways[3].calls)) {
+		fprintf(stderr, "air_data_computer makes more Orbiter calls than the gauges did\n");
+		failed = true;
+	}
+	if (ways[4].best > ways[3].best) {
+		fprintf(stderr, "the avionics frame is slower through the flight_state\n");
+		failed = true;
+	}
+
+	return failed ? 1 : 0;
+}
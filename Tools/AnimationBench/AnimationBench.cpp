@@ -0,0 +1,163 @@
+//	AnimationBench - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Steps 1,000 target and 1,000 wrap animations three ways: one animation_base object each (the
+// old per control step), the scalar update_state over the animation_store arrays, and
+// animation_kernel (SSE2 where the build has it).  The kernel must give exactly the scalar
+// states every frame.  Built against the SDK stand-in in Tools/OrbiterStub:
+//
+//	g++ -std=c++20 -O2 -I../OrbiterStub -I../../bc_orbiter AnimationBench.cpp -o AnimationBench
+//	cl /std:c++20 /O2 /EHsc /I..\OrbiterStub /I..\..\bc_orbiter AnimationBench.cpp
+//
+//	AnimationBench [count]		ns per frame for each way, default 1,000 animations per policy.
+//								Exits 1 if the kernel and scalar states differ.
+
+#include "animation_store.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	const int FRAMES = 2000;
+	const double DT = 0.02;
+
+	// Targets for every frame, about one animation in twenty retargeted per frame so most are moving or just settled.
+	std::vector<std::vector<double>> make_targets(size_t count, unsigned seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<double> pos(0.0, 1.0);
+		std::uniform_int_distribution<int> pick(0, 19);
+
+		std::vector<std::vector<double>> frames(FRAMES, std::vector<double>(count));
+		std::vector<double> current(count);
+		for (auto& t : current) t = pos(rng);
+
+		for (auto& f : frames) {
+			for (size_t i = 0; i < count; i++) {
+				if (pick(rng) == 0) current[i] = (pick(rng) < 4) ? (pick(rng) % 2) : pos(rng);		// Some exactly 0 or 1.
+				f[i] = current[i];
+			}
+		}
+		return frames;
+	}
+
+	std::vector<double> make_speeds(size_t count)
+	{
+		std::mt19937 rng(7);
+		std::uniform_real_distribution<double> speed(0.05, 3.0);
+		std::vector<double> s(count);
+		for (auto& v : s) v = speed(rng);
+		return s;
+	}
+
+	template<typename T>
+	bool check(const char* name, size_t count)
+	{
+		auto targets = make_targets(count, 11);
+		auto speed = make_speeds(count);
+		std::vector<double> scalar(count, 0.0);
+		std::vector<double> kernel(count, 0.0);
+
+		for (int f = 0; f < FRAMES; f++) {
+			auto& target = targets[f];
+			auto dt = DT * (1 + (f % 3));
+			for (size_t i = 0; i < count; i++) {
+				bco::state_update su{ speed[i], scalar[i], target[i] };
+				T::update_state(su, dt);
+				scalar[i] = su.state_;
+			}
+			bco::animation_kernel<T>::step(kernel.data(), target.data(), speed.data(), count, dt);
+
+			if (memcmp(scalar.data(), kernel.data(), count * sizeof(double)) != 0) {
+				for (size_t i = 0; i < count; i++) {
+					if (scalar[i] == kernel[i]) continue;
+					fprintf(stderr, "%s frame %d animation %zu: scalar %.17g, kernel %.17g\n", name, f, i, scalar[i], kernel[i]);
+					break;
+				}
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename T>
+	void bench(const char* name, size_t count)
+	{
+		auto targets = make_targets(count, 3);
+		auto speed = make_speeds(count);
+
+		auto time = [&](const char* how, auto frame) {
+			auto start = std::chrono::steady_clock::now();
+			for (int f = 0; f < FRAMES; f++) frame(targets[f]);
+			std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+			printf("  %-10s %10.1f ns per frame\n", how, ns.count() / FRAMES);
+		};
+
+		printf("%s, %zu animations\n", name, count);
+
+		std::vector<std::unique_ptr<bco::animation_base<T>>> objects;
+		for (size_t i = 0; i < count; i++) objects.push_back(std::make_unique<bco::animation_base<T>>(speed[i]));
+		time("objects", [&](const std::vector<double>& target) {
+			for (size_t i = 0; i < count; i++) objects[i]->Step(target[i], DT);
+		});
+
+		std::vector<double> state(count, 0.0);
+		time("scalar", [&](const std::vector<double>& target) {
+			for (size_t i = 0; i < count; i++) {
+				bco::state_update su{ speed[i], state[i], target[i] };
+				T::update_state(su, DT);
+				state[i] = su.state_;
+			}
+		});
+
+		// The store keeps its targets in place, copy them in as controls setting their targets would.
+		std::vector<double> kernelState(count, 0.0);
+		std::vector<double> kernelTarget(count);
+		time("kernel", [&](const std::vector<double>& target) {
+			memcpy(kernelTarget.data(), target.data(), count * sizeof(double));
+			bco::animation_kernel<T>::step(kernelState.data(), kernelTarget.data(), speed.data(), count, DT);
+		});
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	size_t count = (argc > 1) ? atoi(argv[1]) : 1000;
+
+#ifdef BCO_ANIMATION_SSE2
+	printf("animation_kernel: SSE2\n");
+#else
+	printf("animation_kernel: scalar\n");
+#endif
+
+	// Odd counts too, so the scalar tail after the two lane loop is covered.
+	for (auto n : { count, count + 1 }) {
+		if (!check<bco::state_update_target>("target", n)) return 1;
+		if (!check<bco::state_update_wrap>("wrap", n)) return 1;
+	}
+
+	bench<bco::state_update_target>("target", count);
+	bench<bco::state_update_wrap>("wrap", count);
+	return 0;
+}
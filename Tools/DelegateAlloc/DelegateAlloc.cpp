@@ -0,0 +1,167 @@
+//	DelegateAlloc - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Counts heap allocations, through a replaced global operator new, while slots, signallers and
+// delegates are built, copied and fired.  delegate (delegate.h) must never allocate; attaching
+// only allocates when a signal's slot list grows.  std::function with the same captures is shown
+// for comparison.  Standalone, no Orbiter headers:
+//
+//	g++ -std=c++20 -O2 -I../../bc_orbiter DelegateAlloc.cpp -o DelegateAlloc
+//	cl /std:c++20 /O2 /EHsc /I..\..\bc_orbiter DelegateAlloc.cpp
+//
+//	DelegateAlloc			Allocations per case.  Exits 1 if a delegate case allocates.
+
+#include "signals.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+	size_t allocations = 0;
+}
+
+void* operator new(size_t size)
+{
+	allocations++;
+	if (auto p = malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	const int COUNT = 1000;
+
+	struct gauge {
+		double	value{ 0.0 };
+		double	scale{ 1.0 };
+		double	offset{ 0.0 };
+		int		changes{ 0 };
+	};
+
+	bool failed = false;
+
+	// Allocations made by 'f', which must be 'expected' unless expected is negative (shown only).
+	template<typename F>
+	void count(const char* name, long expected, F f)
+	{
+		auto start = allocations;
+		f();
+		auto n = static_cast<long>(allocations - start);
+		auto bad = (expected >= 0) && (n != expected);
+		printf("  %-46s %6ld%s\n", name, n, bad ? "  FAIL" : "");
+		failed |= bad;
+	}
+}
+
+int main()
+{
+	// Storage is allocated up front, so only what the cases themselves allocate is counted.
+	std::vector<gauge> gauges(COUNT);
+	auto slotStorage = std::make_unique<std::aligned_storage_t<sizeof(bco::slot<double>), alignof(bco::slot<double>)>[]>(COUNT);
+	auto slots = reinterpret_cast<bco::slot<double>*>(slotStorage.get());
+	auto signallerStorage = std::make_unique<std::aligned_storage_t<sizeof(bco::signaller), alignof(bco::signaller)>[]>(COUNT);
+	auto signallers = reinterpret_cast<bco::signaller*>(signallerStorage.get());
+	std::vector<bco::delegate<void()>> delegates(COUNT);
+	std::vector<std::function<void()>> functions(COUNT);
+
+	bco::signal<double> sig;
+	bco::signaller trigger;
+	double total = 0.0;
+
+	printf("Heap allocations (%d each):\n", COUNT);
+
+	count("slot construction, [this] style capture", 0, [&]() {
+		for (int i = 0; i < COUNT; i++) {
+			auto g = &gauges[i];
+			new (&slots[i]) bco::slot<double>([g](double v) { g->value = v; g->changes++; });
+		}
+	});
+
+	count("slot construction, four reference capture", 0, [&]() {
+		for (int i = 0; i < COUNT; i++) {
+			slots[i].~slot();
+			auto& g = gauges[i];
+			new (&slots[i]) bco::slot<double>([&g, &total, &sig, &trigger](double v) { g.value = v * g.scale + g.offset; g.changes++; total += v; });
+		}
+	});
+
+	count("signaller construction", 0, [&]() {
+		for (int i = 0; i < COUNT; i++) new (&signallers[i]) bco::signaller();
+	});
+
+	count("delegate construction and copy", 0, [&]() {
+		for (int i = 0; i < COUNT; i++) {
+			auto& g = gauges[i];
+			bco::delegate<void()> d([&g, &total]() { g.changes++; total += g.value; });
+			delegates[i] = d;
+		}
+	});
+
+	count("std::function, same four reference capture", -1, [&]() {
+		for (int i = 0; i < COUNT; i++) {
+			auto& g = gauges[i];
+			functions[i] = [&g, &total, &sig, &trigger]() { g.changes++; total += g.value; };
+		}
+	});
+
+	sig.attach(slots[0]);
+	trigger.attach(delegates[0]);
+	count("signal attach (slot list growth only)", -1, [&]() {
+		for (int i = 1; i < COUNT; i++) sig.attach(slots[i]);
+	});
+
+	count("signaller attach (delegate list growth only)", -1, [&]() {
+		for (int i = 1; i < COUNT; i++) trigger.attach(delegates[i]);
+	});
+
+	count("signal fire to every slot", 0, [&]() {
+		for (int i = 0; i < 100; i++) sig.fire(i);
+	});
+
+	count("signaller fire to every delegate", 0, [&]() {
+		for (int i = 0; i < 100; i++) trigger.fire();
+	});
+
+	count("delegate call", 0, [&]() {
+		for (auto& d : delegates) d();
+	});
+
+	for (int i = 0; i < COUNT; i++) {
+		slots[i].~slot();
+		signallers[i].~signaller();
+	}
+
+	// Every slot saw every fired value, one change per value, and every delegate was called.
+	for (auto& g : gauges) {
+		if (g.value != 99.0 * g.scale + g.offset) failed = true;
+		if (g.changes != 100 + 100 + 1) failed = true;
+	}
+
+	if (failed) fprintf(stderr, "delegate allocated or did not deliver\n");
+	return failed ? 1 : 0;
+}
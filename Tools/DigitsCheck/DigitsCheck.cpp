@@ -0,0 +1,122 @@
+//	DigitsCheck - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the batch GetDigits (digits.h) with the fmod form it replaced, GetDigitsLarge, over every
+// value on two grids that cover what the drum displays show: every hundredth from -1,000 to
+// 1,000,000 (altimeter, beacon miles) and every thousandth from -10 to 3,000 (KEAS, mach, course).
+// Values are passed in odd sized batches so the single value tail is covered too.  Then times both.
+// Standalone, no Orbiter headers:
+//
+//	g++ -std=c++20 -O2 -I../../bc_orbiter DigitsCheck.cpp -o DigitsCheck
+//	cl /std:c++20 /O2 /EHsc /I..\..\bc_orbiter DigitsCheck.cpp
+//
+//	DigitsCheck				Values checked per grid and ns per value each way.  Exits 1 if any place
+//							differs.  Places compare with ==, the fmod form gives -0 where the batch
+//							gives 0, which a drum shows the same.
+
+#include "digits.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	const size_t BATCH = 1023;
+
+	struct grid {
+		const char*	name;
+		long long	first;
+		long long	last;
+		double		step;		// Divisor, values are k / step.
+	};
+
+	const grid grids[] = {
+		{ "hundredths, -1,000 to 1,000,000", -100000LL, 100000000LL, 100.0 },
+		{ "thousandths, -10 to 3,000", -10000LL, 3000000LL, 1000.0 },
+	};
+
+	const char* places[] = { "hundredths", "tenths", "tens", "hundreds", "thousands", "ten thousands", "hundred thousands", "millions" };
+
+	size_t check(const grid& g)
+	{
+		std::vector<double> values(BATCH);
+		std::vector<bco::TensParts> batch(BATCH);
+		size_t bad = 0;
+
+		for (auto k = g.first; k <= g.last; k += BATCH) {
+			size_t n = 0;
+			for (; (n < BATCH) && (k + static_cast<long long>(n) <= g.last); n++) values[n] = (k + static_cast<long long>(n)) / g.step;
+			bco::GetDigits(values.data(), batch.data(), n);
+
+			for (size_t i = 0; i < n; i++) {
+				bco::TensParts fmodParts;
+				bco::GetDigitsLarge(values[i], fmodParts);
+
+				const double* a = &batch[i].Hundredths;
+				const double* b = &fmodParts.Hundredths;
+				for (int p = 0; p < 8; p++) {
+					if (a[p] == b[p]) continue;
+					if (bad++ < 10) fprintf(stderr, "%.17g %s: batch %g, fmod %g\n", values[i], places[p], a[p], b[p]);
+					break;
+				}
+			}
+		}
+		return bad;
+	}
+
+	void bench()
+	{
+		const size_t COUNT = 1000000;
+		std::vector<double> values(COUNT);
+		for (size_t i = 0; i < COUNT; i++) values[i] = i * 0.37;
+		std::vector<bco::TensParts> out(COUNT);
+
+		auto time = [&](const char* name, auto f) {
+			auto start = std::chrono::steady_clock::now();
+			f();
+			std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+			double sum = 0.0;
+			for (auto& p : out) sum += p.Hundredths + p.Millions;
+			printf("  %-8s %6.2f ns per value (%g)\n", name, ns.count() / COUNT, sum);
+		};
+
+		printf("Time:\n");
+		time("fmod", [&]() { for (size_t i = 0; i < COUNT; i++) bco::GetDigitsLarge(values[i], out[i]); });
+		time("batch", [&]() { bco::GetDigits(values.data(), out.data(), COUNT); });
+		time("pairs", [&]() { for (size_t i = 0; i < COUNT; i += 2) bco::GetDigits(values.data() + i, out.data() + i, 2); });
+	}
+}
+
+int main()
+{
+	size_t bad = 0;
+	for (auto& g : grids) {
+		auto b = check(g);
+		printf("  %-34s %12lld values  %s\n", g.name, g.last - g.first + 1, (b == 0) ? "same" : "DIFFERENT");
+		bad += b;
+	}
+
+	if (bad != 0) {
+		fprintf(stderr, "%zu values differ from the fmod form\n", bad);
+		return 1;
+	}
+
+	bench();
+	return 0;
+}
@@ -0,0 +1,202 @@
+//	EventBench - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Times vessel event dispatch through the dense event table (vessel.h) against the std::map
+// lookups it replaced, over the same 10,000 mouse and redraw events.  Both must reach the same
+// controls.  Built against the SDK stand-in in Tools/OrbiterStub:
+//
+//	g++ -std=c++20 -O2 -I../OrbiterStub -I../../bc_orbiter EventBench.cpp -o EventBench
+//	cl /std:c++20 /O2 /EHsc /I..\OrbiterStub /I..\..\bc_orbiter EventBench.cpp
+//
+//	EventBench [controls]		ns per event for each path, default 400 controls.  Exits 1 if the
+//								paths deliver different events.
+
+#include "vessel.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	struct bench_control :
+		  public bco::control
+		, public bco::vc_event_target
+		, public bco::panel_event_target
+	{
+		size_t	events{ 0 };
+		size_t	redraws{ 0 };
+
+		bool on_event(int id, int event) override { events++; return true; }
+		void on_vc_redraw(DEVMESHHANDLE meshVC) override { redraws++; }
+		int  vc_mouse_flags() override { return PANEL_MOUSE_LBDOWN; }
+		int  panel_mouse_flags() override { return PANEL_MOUSE_LBDOWN; }
+	};
+
+	struct bench_vessel : public bco::vessel
+	{
+		bench_vessel() : bco::vessel(nullptr, 1) {}
+	};
+
+	// The dispatch vessel.h did before the event table: a map per handler kind, searched in turn.
+	struct map_dispatch
+	{
+		std::map<int, bco::Component*>				idComponentMap_;
+		std::map<int, bco::vc_event_target*>		map_vc_targets_;
+		std::map<int, bco::panel_event_target*>		map_panel_targets_;
+		std::map<int, bco::load_vc*>				map_vc_component_;
+		std::map<int, bco::load_panel*>				map_panel_component_;
+		bco::vessel*								vessel_{ nullptr };
+
+		bool vc_mouse(int id, int event)
+		{
+			auto c = idComponentMap_.find(id);
+			if (c != idComponentMap_.end()) return c->second->OnVCMouseEvent(id, event);
+
+			auto vc = map_vc_targets_.find(id);
+			if (vc != map_vc_targets_.end()) vc->second->on_event(id, event);
+			return false;
+		}
+
+		bool vc_redraw(int id, int event, DEVMESHHANDLE mesh)
+		{
+			auto c = idComponentMap_.find(id);
+			if (c != idComponentMap_.end()) return c->second->OnVCRedrawEvent(id, event, nullptr);
+
+			auto pe = map_vc_targets_.find(id);
+			if (pe != map_vc_targets_.end()) {
+				pe->second->on_vc_redraw(mesh);
+				return true;
+			}
+
+			auto pc = map_vc_component_.find(id);
+			if (pc != map_vc_component_.end()) return pc->second->handle_redraw_vc(*vessel_, id, event, nullptr);
+			return false;
+		}
+
+		bool panel_mouse(int id, int event)
+		{
+			auto c = idComponentMap_.find(id);
+			if (c != idComponentMap_.end()) return c->second->OnPanelMouseEvent(id, event);
+
+			auto pe = map_panel_targets_.find(id);
+			if (pe != map_panel_targets_.end()) pe->second->on_event(id, event);
+			return true;
+		}
+	};
+
+	enum class kind { vc_mouse, vc_redraw, panel_mouse };
+
+	struct event {
+		kind	k;
+		int		id;
+	};
+
+	size_t total_events(const std::vector<bench_control>& controls)
+	{
+		size_t n = 0;
+		for (auto& c : controls) n += c.events + c.redraws;
+		return n;
+	}
+
+	void reset(std::vector<bench_control>& controls)
+	{
+		for (auto& c : controls) c.events = c.redraws = 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int count = (argc > 1) ? atoi(argv[1]) : 400;
+	const int EVENTS = 10000;
+	const int PASSES = 200;
+
+	std::vector<bench_control> controls(count);
+	bench_vessel v;
+	map_dispatch old;
+	old.vessel_ = &v;
+	for (auto& c : controls) {
+		v.AddControl(&c);
+		old.map_vc_targets_[c.get_id()] = &c;
+		old.map_panel_targets_[c.get_id()] = &c;
+	}
+	v.clbkSetClassCaps(nullptr);		// Orbiter calls it once the vessel is constructed.
+
+	auto mesh = reinterpret_cast<VISHANDLE>(&v);
+	v.clbkVisualCreated(mesh, 1);
+
+	// Mostly mouse events, one id in ten not registered.
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> id(0, count + count / 10);
+	std::uniform_int_distribution<int> k(0, 2);
+	std::vector<event> events;
+	for (int i = 0; i < EVENTS; i++) events.push_back({ static_cast<kind>(k(rng)), id(rng) });
+
+	VECTOR3 p{ 0.0, 0.0, 0.0 };
+	auto run_new = [&]() {
+		for (auto& e : events) {
+			switch (e.k) {
+			case kind::vc_mouse:	v.clbkVCMouseEvent(e.id, PANEL_MOUSE_LBDOWN, p); break;
+			case kind::vc_redraw:	v.clbkVCRedrawEvent(e.id, PANEL_REDRAW_USER, nullptr); break;
+			case kind::panel_mouse:	v.clbkPanelMouseEvent(e.id, PANEL_MOUSE_LBDOWN, 0, 0); break;
+			}
+		}
+	};
+
+	auto run_old = [&]() {
+		for (auto& e : events) {
+			switch (e.k) {
+			case kind::vc_mouse:	old.vc_mouse(e.id, PANEL_MOUSE_LBDOWN); break;
+			case kind::vc_redraw:	old.vc_redraw(e.id, PANEL_REDRAW_USER, mesh); break;
+			case kind::panel_mouse:	old.panel_mouse(e.id, PANEL_MOUSE_LBDOWN); break;
+			}
+		}
+	};
+
+	// Both paths must hit the same controls the same number of times.
+	reset(controls);
+	run_old();
+	std::vector<size_t> expected;
+	for (auto& c : controls) { expected.push_back(c.events); expected.push_back(c.redraws); }
+
+	reset(controls);
+	run_new();
+	for (size_t i = 0; i < controls.size(); i++) {
+		if ((controls[i].events != expected[i * 2]) || (controls[i].redraws != expected[i * 2 + 1])) {
+			fprintf(stderr, "control %zu: table dispatch %zu/%zu events/redraws, map dispatch %zu/%zu\n",
+				i, controls[i].events, controls[i].redraws, expected[i * 2], expected[i * 2 + 1]);
+			return 1;
+		}
+	}
+
+	auto time = [&](const char* name, auto run) {
+		run();
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < PASSES; i++) run();
+		std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+		printf("  %-8s %8.2f ns per event\n", name, ns.count() / (static_cast<double>(PASSES) * EVENTS));
+	};
+
+	printf("%d controls, %d events (%zu delivered)\n", count, EVENTS, total_events(controls));
+	time("maps", run_old);
+	time("table", run_new);
+	return 0;
+}
@@ -0,0 +1,277 @@
+//	FlightStateCalls - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Counts the Orbiter vessel API calls clbkPostStep makes per frame for the avionics consumers of
+// the flight_state (flight_state.h, vessel::GetFlightState), three ways:
+//
+//	baseline	Each consumer calls Orbiter itself, as Avionics, Airspeed, Altimeter, HSI and the
+//				avionics_provider overrides the control programs use did before the flight_state.
+//	eager		The whole flight_state is filled the first time anything reads it.
+//	lazy		Each field is fetched the first time it is read, what vessel does now.
+//
+// The consumers are models of those handle_post_step functions, reading the same values.  Built
+// against the SDK stand-in in Tools/OrbiterStub, which counts the calls:
+//
+//	g++ -std=c++20 -O2 -I../OrbiterStub -I../../bc_orbiter FlightStateCalls.cpp -o FlightStateCalls
+//	cl /std:c++20 /O2 /EHsc /I..\OrbiterStub /I..\..\bc_orbiter FlightStateCalls.cpp
+//
+//	FlightStateCalls		API calls per frame for each case and way.  Exits 1 if the lazy fill makes
+//							more calls than the baseline, makes any with nothing powered, or a consumer
+//							reads a value different from the baseline.
+
+#include "air_data_computer.h"
+#include "vessel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	enum class way { baseline, eager, lazy };
+
+	way		current = way::lazy;
+	bool	powered = false;
+	bool	failed = false;
+
+	const double MAX_PRESS = 60000.0;		// Airspeed::MaxPress
+	const double MAX_MACH = 22.0;			// Airspeed::MAX_MACH
+
+	/**
+	consumer
+	A model of one avionics post step.  'shown' sums what it read, compared across the ways.
+	*/
+	struct consumer :
+		  public bco::vessel_component
+		, public bco::post_step
+	{
+		double	shown{ 0.0 };
+
+		void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override {
+			shown = 0.0;
+			if (!powered) return;
+			shown = (current == way::baseline) ? direct(vessel) : snapshot(vessel, vessel.GetFlightState());
+		}
+
+		virtual double direct(bco::vessel& vessel) = 0;
+		virtual double snapshot(bco::vessel& vessel, const bco::flight_state& fs) = 0;
+	};
+
+	// The eager fill: everything, the first time anything reads it.
+	struct eager_fill : public consumer
+	{
+		double direct(bco::vessel& vessel) override { return 0.0; }
+		double snapshot(bco::vessel& vessel, const bco::flight_state& fs) override {
+			if (current == way::eager) {
+				fs.pitch(); fs.bank(); fs.yaw(); fs.aoa(); fs.altitude(); fs.altitude_ground();
+				fs.mach(); fs.airspeed(); fs.atm_pressure(); fs.atm_density(); fs.dyn_pressure();
+				fs.angular_vel(); fs.vertical_speed();
+			}
+			return 0.0;
+		}
+	};
+
+	struct avionics : public consumer
+	{
+		double direct(bco::vessel& vessel) override {
+			return vessel.GetAOA() + bco::GetVerticalSpeedFPM(&vessel) + vessel.GetPitch() + vessel.GetBank() + vessel.GetDynPressure();
+		}
+		double snapshot(bco::vessel& vessel, const bco::flight_state& fs) override {
+			return fs.aoa() + fs.vertical_speed_fpm() + fs.pitch() + fs.bank() + fs.dyn_pressure();
+		}
+	};
+
+	// Atmosphere mode.  Now the air data comes from the air_data_computer, which reads the snapshot.
+	struct airspeed : public consumer
+	{
+		bco::air_data_computer&	airData;
+
+		explicit airspeed(bco::air_data_computer& a) : airData(a) {}
+
+		double direct(bco::vessel& vessel) override {
+			auto keas = bco::GetVesselKeas(&vessel);
+			auto kias = bco::GetVesselKias(&vessel);
+			auto mach = vessel.GetMachNumber();
+			auto maxMach = 0.0;
+			auto atmDens = vessel.GetAtmDensity();
+			if (atmDens > 0.0) maxMach = sqrt(MAX_PRESS / atmDens) / 331.34;
+			return keas + kias + mach + maxMach;
+		}
+		double snapshot(bco::vessel& vessel, const bco::flight_state& fs) override {
+			return airData.KeasSignal().current() + airData.KiasSignal().current() + airData.MachSignal().current() + airData.MaxMachSignal().current();
+		}
+	};
+
+	struct altimeter : public consumer
+	{
+		double direct(bco::vessel& vessel) override {
+			int res = 0;
+			return vessel.GetAltitude(AltitudeMode::ALTMODE_GROUND, &res);
+		}
+		double snapshot(bco::vessel& vessel, const bco::flight_state& fs) override { return fs.altitude_ground(); }
+	};
+
+	// No nav source is tuned, so the glide slope altitude is not read.
+	struct hsi : public consumer
+	{
+		double direct(bco::vessel& vessel) override { return vessel.GetYaw(); }
+		double snapshot(bco::vessel& vessel, const bco::flight_state& fs) override { return fs.yaw(); }
+	};
+
+	// The five control programs running: heading, altitude, KEAS, mach and attitude hold.
+	struct programs : public consumer
+	{
+		double direct(bco::vessel& vessel) override {
+			VECTOR3 v;
+			vessel.GetAngularVel(v);
+			return vessel.GetYaw() + vessel.GetBank()
+				+ vessel.GetAltitude() + bco::GetVerticalSpeedFPM(&vessel)
+				+ bco::GetVesselKeas(&vessel)
+				+ vessel.GetMachNumber()
+				+ vessel.GetPitch() + vessel.GetBank() + v.x;
+		}
+		double snapshot(bco::vessel& vessel, const bco::flight_state& fs) override {
+			return fs.yaw() + fs.bank()
+				+ fs.altitude() + fs.vertical_speed_fpm()
+				+ fs.keas()
+				+ fs.mach()
+				+ fs.pitch() + fs.bank() + fs.angular_vel().x;
+		}
+	};
+
+	struct bench_vessel : public bco::vessel
+	{
+		bench_vessel() : bco::vessel(nullptr, 1) {}
+	};
+
+	/**
+	setup
+	One vessel with the consumers of a case, registered in the SR71Vessel order.
+	*/
+	struct setup
+	{
+		bench_vessel				v;
+		bco::air_data_computer		airData{ MAX_PRESS, MAX_MACH, []() { return powered && (current != way::baseline); } };
+		eager_fill					eager;
+		avionics					avionicsGauges;
+		airspeed					airspeedGauges{ airData };
+		altimeter					altimeterGauges;
+		hsi							hsiGauges;
+		programs					autopilot;
+		std::vector<consumer*>		consumers;
+
+		explicit setup(bool withPrograms)
+		{
+			add(&eager);
+			add(&avionicsGauges);
+			v.AddComponent(&airData);
+			add(&airspeedGauges);
+			add(&altimeterGauges);
+			add(&hsiGauges);
+			if (withPrograms) add(&autopilot);
+		}
+
+		void add(consumer* c)
+		{
+			v.AddComponent(c);
+			consumers.push_back(c);
+		}
+	};
+
+	// Values change every frame, so a value kept from the last frame shows as a difference.
+	void set_frame(int f)
+	{
+		auto& s = orbiter_stub::values;
+		s.pitch = 0.01 * f;			s.bank = 0.02 * f;			s.yaw = 0.03 * f;			s.aoa = 0.04 * f;
+		s.altitude = 1000.0 * f;	s.altitudeGround = 900.0 * f;
+		s.mach = 2.0 + 0.01 * f;	s.airspeed = 600.0 + f;		s.atmPressure = 5000.0 - f;
+		s.atmDensity = 0.05 - 0.0001 * f;	s.dynPressure = 20000.0 + f;
+		s.airspeedHorizon = { 0.0, 1.0 * f, 0.0 };			s.angularVel = { 0.001 * f, 0.0, 0.0 };
+	}
+
+	const int FRAMES = 10;
+
+	/**
+	run
+	Average API calls per frame over FRAMES frames, and what each consumer showed on each frame.
+	*/
+	double run(bool withPrograms, way w, std::vector<double>& shown)
+	{
+		current = w;
+		setup s(withPrograms);
+
+		shown.clear();
+		auto start = orbiter_stub::apiCalls;
+		for (int f = 1; f <= FRAMES; f++) {
+			set_frame(f);
+			s.v.clbkPostStep(f * 0.02, 0.02, 0.0);
+			for (auto c : s.consumers) shown.push_back(c->shown);
+		}
+		return static_cast<double>(orbiter_stub::apiCalls - start) / FRAMES;
+	}
+
+	// The air_data_computer KIAS uses cached exponents, so allow for rounding.
+	bool same(const std::vector<double>& a, const std::vector<double>& b)
+	{
+		if (a.size() != b.size()) return false;
+		for (size_t i = 0; i < a.size(); i++) {
+			if (std::fabs(a[i] - b[i]) > 1e-9 * std::max(1.0, std::fabs(b[i]))) return false;
+		}
+		return true;
+	}
+
+	void compare(const char* name, bool withPrograms, double overhead)
+	{
+		std::vector<double> base, eager, lazy;
+		auto b = run(withPrograms, way::baseline, base);
+		auto e = run(withPrograms, way::eager, eager);
+		auto l = run(withPrograms, way::lazy, lazy);
+
+		auto stale = !same(eager, base) || !same(lazy, base);
+		auto bad = stale || (l > b) || (!powered && (l != overhead));
+		printf("  %-26s %8.1f %8.1f %8.1f%s\n", name, b, e, l, bad ? "  FAIL" : "");
+		if (stale) fprintf(stderr, "%s: a consumer read a different value than the baseline\n", name);
+		failed |= bad;
+	}
+}
+
+int main()
+{
+	orbiter_stub::values.atmRef = &orbiter_stub::values;		// Any non null handle, so the air data is worked out.
+
+	// What the vessel calls every frame with no components at all.
+	bench_vessel bare;
+	auto start = orbiter_stub::apiCalls;
+	for (int f = 1; f <= FRAMES; f++) bare.clbkPostStep(f * 0.02, 0.02, 0.0);
+	auto overhead = static_cast<double>(orbiter_stub::apiCalls - start) / FRAMES;
+
+	printf("API calls per frame, %.0f of them vessel overhead:\n", overhead);
+	printf("  %-26s %8s %8s %8s\n", "", "baseline", "eager", "lazy");
+
+	powered = false;
+	compare("gauges, unpowered", false, overhead);
+	compare("gauges and programs, off", true, overhead);
+
+	powered = true;
+	compare("gauges, powered", false, overhead);
+	compare("gauges and programs", true, overhead);
+
+	if (failed) fprintf(stderr, "the flight_state made extra calls or gave stale values\n");
+	return failed ? 1 : 0;
+}
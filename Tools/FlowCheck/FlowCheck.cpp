@@ -0,0 +1,129 @@
+//	FlowCheck - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Runs integrate_flow (consumable_flow.h) over tank cases with fill to full, draw to empty and
+// boil off, once as a single step of the whole time (time warp) and once as 20 ms steps (1x).  The
+// pump stops when the tank fills, as resource_table does.  Both must end with the same contents,
+// the same amounts filled, drawn and boiled, and the same full and empty times.  Standalone, no
+// Orbiter headers:
+//
+//	g++ -std=c++20 -O2 -I../../bc_orbiter FlowCheck.cpp -o FlowCheck
+//	cl /std:c++20 /O2 /EHsc /I..\..\bc_orbiter FlowCheck.cpp
+//
+//	FlowCheck				Largest difference per case.  Exits 1 if an amount differs by more than
+//							1e-9 of the capacity or an event time by more than 1 us.  The 20 ms steps
+//							add up thousands of rounded pieces, so bit for bit is not expected.
+
+#include "consumable_flow.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	struct flow_case {
+		const char*		name;
+		double			capacity;
+		double			level;
+		bco::flow_rates	rates;
+		double			time;		// Seconds.
+		bool			full;		// Expect a full event.
+		bool			empty;		// Expect an empty event.
+	};
+
+	// Boil off rates are per second, O2_NER and HYDRO_NER in ShipMets.h are a few percent per hour.
+	const flow_case cases[] = {
+		{ "fill to full, boil off",				100.0, 10.0,	{ 0.5, 0.0, 0.03 / 3600 },	3600.0,	true,	false },
+		{ "fill against a draw, then empty",	80.0,  0.0,		{ 0.4, 0.1, 0.05 / 3600 },	3600.0,	true,	true },
+		{ "fill, then drain to empty",			50.0,  49.0,	{ 0.2, 0.05, 0.02 / 3600 },	7200.0,	true,	true },
+		{ "draw to empty, boil off",			100.0, 60.0,	{ 0.0, 0.02, 0.04 / 3600 },	7200.0,	false,	true },
+		{ "draw more than fills, empty",		100.0, 5.0,		{ 0.01, 0.03, 0.01 / 3600 },	3600.0,	false,	true },
+		{ "boil off only",						100.0, 100.0,	{ 0.0, 0.0, 0.05 / 3600 },	36000.0, false,	false },
+		{ "fill to full, no boil off",			100.0, 0.0,		{ 0.25, 0.0, 0.0 },			1000.0,	true,	false },
+		{ "draw to empty, no boil off",			100.0, 100.0,	{ 0.0, 0.3, 0.0 },			1000.0,	false,	true },
+		{ "full tank, pump on",					100.0, 100.0,	{ 1.0, 0.0, 0.03 / 3600 },	600.0,	true,	false },
+		{ "empty tank, draw on",				100.0, 0.0,		{ 0.0, 1.0, 0.0 },			600.0,	false,	true },
+	};
+
+	struct totals {
+		double	level{ 0.0 };
+		double	filled{ 0.0 };
+		double	drawn{ 0.0 };
+		double	boiled{ 0.0 };
+		double	fullAt{ -1.0 };
+		double	emptyAt{ -1.0 };
+	};
+
+	// Steps the case in steps of 'dt' (the last one short), stopping the pump when the tank fills.
+	totals run(const flow_case& c, double dt)
+	{
+		totals r;
+		r.level = c.level;
+		auto rates = c.rates;
+		double t = 0.0;
+		while (t < c.time) {
+			auto step = std::min(dt, c.time - t);
+			auto f = bco::integrate_flow(r.level, c.capacity, rates, step);
+			r.level = f.level;
+			r.filled += f.filled;
+			r.drawn += f.drawn;
+			r.boiled += f.boiled;
+			if ((f.fullAt >= 0.0) && (r.fullAt < 0.0)) r.fullAt = t + f.fullAt;
+			if ((f.emptyAt >= 0.0) && (r.emptyAt < 0.0)) r.emptyAt = t + f.emptyAt;
+			if (f.fullAt >= 0.0) rates.fill = 0.0;
+			t += step;
+		}
+		return r;
+	}
+
+	bool failed = false;
+
+	void compare(const flow_case& c)
+	{
+		auto warp = run(c, c.time);
+		auto real = run(c, 0.02);
+
+		const double amounts[][2] = {
+			{ warp.level, real.level }, { warp.filled, real.filled }, { warp.drawn, real.drawn }, { warp.boiled, real.boiled } };
+		double worstAmount = 0.0;
+		for (auto& a : amounts) worstAmount = std::max(worstAmount, std::fabs(a[0] - a[1]) / c.capacity);
+
+		auto event = [](double a, double b) { return ((a < 0.0) != (b < 0.0)) ? INFINITY : std::fabs(a - b); };
+		auto worstTime = std::max(event(warp.fullAt, real.fullAt), event(warp.emptyAt, real.emptyAt));
+
+		// The contents must add up too: start + filled - drawn - boiled.
+		auto balance = std::fabs(c.level + warp.filled - warp.drawn - warp.boiled - warp.level) / c.capacity;
+		auto missed = ((warp.fullAt >= 0.0) != c.full) || ((warp.emptyAt >= 0.0) != c.empty);
+
+		auto bad = (worstAmount > 1e-9) || (worstTime > 1e-6) || (balance > 1e-9) || missed;
+		printf("  %-32s %10.3g %10.3g %10.3g%s\n", c.name, worstAmount, worstTime, balance, bad ? "  FAIL" : "");
+		if (missed) fprintf(stderr, "%s: full %g, empty %g, not the events expected\n", c.name, warp.fullAt, warp.emptyAt);
+		failed |= bad;
+	}
+}
+
+int main()
+{
+	printf("One step against 20 ms steps, largest difference:\n");
+	printf("  %-32s %10s %10s %10s\n", "", "amount", "event s", "balance");
+	for (auto& c : cases) compare(c);
+
+	if (failed) fprintf(stderr, "integrate_flow depends on the step size\n");
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,358 @@
+//	Orbitersdk - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Stand-in for the parts of the Orbiter SDK that bc_orbiter and the SR71R sources use, so the Tools
+// harnesses can compile the real headers with any compiler.  Put this directory first on the include
+// path.  Never used by the addon build.
+//
+// The vessel getters return the values in orbiter_stub::values and count themselves in
+// orbiter_stub::apiCalls.  They are never inlined, like the calls into Orbiter they stand in for,
+// so the harnesses time a call as a call.  oapiWriteLogV keeps the last line in orbiter_stub::lastLog and
+// oapiWriteScenario_string adds its line to orbiter_stub::scenario.  The drag functions use the
+// formulas documented for Orbiter, everything else does nothing.
+
+#include "windows.h"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <cstdarg>
+#include <cstdio>
+
+#define DLLCLBK extern "C"
+#ifdef _MSC_VER
+#define STUB_CALL __declspec(noinline)
+#else
+#define STUB_CALL __attribute__((noinline))
+#endif
+#define OAPIFUNC
+const double PI = 3.14159265358979323846;
+const double PI05 = PI / 2;
+const double PI2 = PI * 2;
+const double RAD = PI / 180.0;
+const double DEG = 180.0 / PI;
+const double ATMP = 101.4e3;
+
+struct VECTOR3 { double x, y, z; };
+inline VECTOR3 _V(double x, double y, double z) { return VECTOR3{ x, y, z }; }
+inline VECTOR3 operator-(const VECTOR3& a, const VECTOR3& b) { return _V(a.x - b.x, a.y - b.y, a.z - b.z); }
+inline VECTOR3 operator+(const VECTOR3& a, const VECTOR3& b) { return _V(a.x + b.x, a.y + b.y, a.z + b.z); }
+inline VECTOR3 operator/(const VECTOR3& a, double f) { return _V(a.x / f, a.y / f, a.z / f); }
+inline VECTOR3 operator*(const VECTOR3& a, double f) { return _V(a.x * f, a.y * f, a.z * f); }
+inline double length(const VECTOR3& a) { return std::sqrt(a.x * a.x + a.y * a.y + a.z * a.z); }
+inline void normalise(VECTOR3& a) { double l = length(a); a.x /= l; a.y /= l; a.z /= l; }
+struct MATRIX3 { double m11, m12, m13, m21, m22, m23, m31, m32, m33; };
+inline VECTOR3 mul(const MATRIX3& m, const VECTOR3& v) { return _V(m.m11 * v.x + m.m12 * v.y + m.m13 * v.z, m.m21 * v.x + m.m22 * v.y + m.m23 * v.z, m.m31 * v.x + m.m32 * v.y + m.m33 * v.z); }
+inline RECT _R(int l, int t, int r, int b) { return RECT{ l, t, r, b }; }
+
+typedef void* OBJHANDLE; typedef void* MESHHANDLE; typedef void* DEVMESHHANDLE; typedef void* SURFHANDLE;
+typedef void* FILEHANDLE; typedef void* VISHANDLE; typedef void* PANELHANDLE; typedef void* THRUSTER_HANDLE;
+typedef void* PROPELLANT_HANDLE; typedef void* NAVHANDLE; typedef void* ANIMATIONCOMPONENT_HANDLE;
+typedef void* CTRLSURFHANDLE; typedef void* THGROUP_HANDLE; typedef void* AIRFOILHANDLE;
+
+struct NTVERTEX { float x, y, z, nx, ny, nz, tu, tv; };
+struct MESHGROUP { NTVERTEX* Vtx; WORD* Idx; DWORD nVtx; DWORD nIdx; DWORD MtrlIdx; DWORD TexIdx; DWORD UsrFlag; WORD zBias; WORD Flags; };
+struct GROUPEDITSPEC { DWORD flags; DWORD UsrFlag; NTVERTEX* Vtx; DWORD nVtx; WORD* vIdx; };
+const DWORD GRPEDIT_VTXCRD = 0x07, GRPEDIT_VTXTEX = 0x180, GRPEDIT_VTX = 0x1ff;
+
+struct MGROUP_TRANSFORM { virtual ~MGROUP_TRANSFORM() {} UINT mesh{ 0 }; UINT* grp{ nullptr }; UINT ngrp{ 0 }; };
+struct MGROUP_ROTATE : MGROUP_TRANSFORM { MGROUP_ROTATE(UINT m, UINT* g, size_t n, const VECTOR3&, const VECTOR3&, float) { mesh = m; grp = g; ngrp = (UINT)n; } };
+struct MGROUP_TRANSLATE : MGROUP_TRANSFORM { MGROUP_TRANSLATE(UINT m, UINT* g, size_t n, const VECTOR3&) { mesh = m; grp = g; ngrp = (UINT)n; } };
+
+struct ATMCONST { double p0, rho0, R, gamma, C, O2pp, altlimit, radlimit, horizonalt; VECTOR3 color0; };
+struct HUDPAINTSPEC { int W, H, CX, CY; double Scale; int Markersize; };
+struct VESSELSTATUS2 { DWORD version; DWORD flag; OBJHANDLE rbody, base; int port; int status; VECTOR3 rpos, rvel, vrot, arot; double surf_lng, surf_lat, surf_hdg; };
+struct BEACONLIGHTSPEC { DWORD shape; VECTOR3* pos; VECTOR3* col; double size, falloff, period, duration, tofs; bool active; };
+struct EXHAUSTSPEC { THRUSTER_HANDLE th; double* level; VECTOR3* lpos; VECTOR3* ldir; double lsize, wsize, lofs, modulate; SURFHANDLE tex; DWORD flags; UINT id; };
+struct PARTICLESTREAMSPEC { DWORD flags; double srcsize, srcrate, v0, srcspread, lifetime, growthrate, atmslowdown; enum LTYPE { EMISSIVE, DIFFUSE } ltype; enum LEVELMAP { LVL_FLAT, LVL_LIN, LVL_SQRT, LVL_PLIN, LVL_PSQRT } levelmap; double lmin, lmax; enum ATMSMAP { ATM_FLAT, ATM_PLIN, ATM_PLOG } atmsmap; double amin, amax; SURFHANDLE tex; };
+struct TOUCHDOWNVTX { VECTOR3 pos; double stiffness, damping, mu, mu_lng; };
+struct VCMFDSPEC { DWORD nmesh, ngroup; };
+struct VCHUDSPEC { DWORD nmesh, ngroup; VECTOR3 hudcnt; double size; };
+struct NAVDATA { int type; };
+struct MFDMODESPECEX { char* name; DWORD key; void* context; int (*msgproc)(UINT, UINT, WPARAM, LPARAM); };
+
+enum AltitudeMode { ALTMODE_MEANRAD, ALTMODE_GROUND };
+enum THGROUP_TYPE { THGROUP_MAIN, THGROUP_RETRO, THGROUP_HOVER, THGROUP_ATT_PITCHUP, THGROUP_ATT_PITCHDOWN, THGROUP_ATT_YAWLEFT, THGROUP_ATT_YAWRIGHT, THGROUP_ATT_BANKLEFT, THGROUP_ATT_BANKRIGHT, THGROUP_ATT_RIGHT, THGROUP_ATT_LEFT, THGROUP_ATT_UP, THGROUP_ATT_DOWN, THGROUP_ATT_FORWARD, THGROUP_ATT_BACK };
+enum AIRCTRL_TYPE { AIRCTRL_ELEVATOR, AIRCTRL_RUDDER, AIRCTRL_AILERON, AIRCTRL_FLAP, AIRCTRL_ELEVATORTRIM, AIRCTRL_RUDDERTRIM };
+enum REFFRAME { FRAME_GLOBAL, FRAME_LOCAL, FRAME_REFLOCAL, FRAME_HORIZON };
+enum AIRFOIL_ORIENTATION { LIFT_VERTICAL, LIFT_HORIZONTAL };
+const int AIRCTRL_AXIS_AUTO = 0, AIRCTRL_AXIS_YPOS = 1, AIRCTRL_AXIS_YNEG = 2, AIRCTRL_AXIS_XPOS = 3, AIRCTRL_AXIS_XNEG = 4;
+const int PANEL_REDRAW_NEVER = 0, PANEL_REDRAW_ALWAYS = 1, PANEL_REDRAW_MOUSE = 2, PANEL_REDRAW_INIT = 4, PANEL_REDRAW_USER = 8;
+const int PANEL_MOUSE_IGNORE = 0, PANEL_MOUSE_LBDOWN = 1, PANEL_MOUSE_RBDOWN = 2, PANEL_MOUSE_LBUP = 4, PANEL_MOUSE_RBUP = 8, PANEL_MOUSE_LBPRESSED = 16, PANEL_MOUSE_RBPRESSED = 32, PANEL_MOUSE_DOWN = 3, PANEL_MOUSE_UP = 12, PANEL_MOUSE_PRESSED = 48, PANEL_MOUSE_ONREPLAY = 64;
+const int PANEL_MAP_NONE = 0, PANEL_MAP_BACKGROUND = 1, PANEL_MAP_CURRENT = 2, PANEL_MAP_BGONREQUEST = 3;
+const int PANEL_ATTACH_BOTTOM = 1, PANEL_ATTACH_TOP = 2, PANEL_MOVEOUT_BOTTOM = 4, PANEL_MOVEOUT_TOP = 8;
+const int COCKPIT_GENERIC = 1, COCKPIT_PANELS = 2, COCKPIT_VIRTUAL = 3;
+const int MFD_LEFT = 0, MFD_RIGHT = 1, MFD_NONE = 0;
+const int HUD_NONE = 0, HUD_ORBIT = 1, HUD_SURFACE = 2, HUD_DOCKING = 3;
+const int RCS_NONE = 0, RCS_ROT = 1, RCS_LIN = 2;
+const int NAVMODE_KILLROT = 1, NAVMODE_HLEVEL = 2, NAVMODE_PROGRADE = 3, NAVMODE_RETROGRADE = 4, NAVMODE_NORMAL = 5, NAVMODE_ANTINORMAL = 6, NAVMODE_HOLDALT = 7;
+const int TRANSMITTER_NONE = 0, TRANSMITTER_VOR = 1, TRANSMITTER_VTOL = 2, TRANSMITTER_ILS = 3;
+const int MESHVIS_NEVER = 0, MESHVIS_EXTERNAL = 1, MESHVIS_COCKPIT = 2, MESHVIS_VC = 4;
+const int BEACONSHAPE_COMPACT = 0, BEACONSHAPE_DIFFUSE = 1, BEACONSHAPE_STAR = 2;
+const UINT OAPI_MSG_MFD_OPENED = 1;
+const DWORD OAPI_KEY_1 = 2, OAPI_KEY_2 = 3, OAPI_KEY_3 = 4, OAPI_KEY_4 = 5, OAPI_KEY_5 = 6, OAPI_KEY_6 = 7, OAPI_KEY_B = 0x30, OAPI_KEY_G = 0x22, OAPI_KEY_T = 0x14, OAPI_KEY_SPACE = 0x39, OAPI_KEY_F1 = 0x3B, OAPI_KEY_GRAVE = 0x29;
+#define KEYMOD_SHIFT(buf) ((buf)[0] & 0x80)
+#define KEYMOD_CONTROL(buf) ((buf)[1] & 0x80)
+#define KEYMOD_ALT(buf) ((buf)[2] & 0x80)
+
+namespace oapi {
+	class Font {};
+	class Sketchpad {
+	public:
+		virtual ~Sketchpad() {}
+		virtual bool Text(int x, int y, const char* str, int len) { return true; }
+		virtual bool Rectangle(int l, int t, int r, int b) { return true; }
+		virtual bool Ellipse(int l, int t, int r, int b) { return true; }
+		virtual void Line(int x0, int y0, int x1, int y1) {}
+		virtual void MoveTo(int x, int y) {}
+		virtual void LineTo(int x, int y) {}
+		virtual Font* SetFont(Font* f) const { return nullptr; }
+		virtual DWORD SetTextColor(DWORD c) { return 0; }
+		virtual DWORD GetCharSize() { return 0; }
+		virtual DWORD GetTextWidth(const char* str, int len = 0) { return 0; }
+		virtual void SetTextAlign(int, int = 0) {}
+		enum TAlign_horizontal { LEFT, CENTER, RIGHT };
+		enum TAlign_vertical { TOP, BASELINE, BOTTOM };
+	};
+}
+const int FONT_NORMAL = 0;
+
+class MFD2 {
+public:
+	MFD2(DWORD w, DWORD h, void* vessel) : W(w), H(h) {}
+	virtual ~MFD2() {}
+	virtual bool Update(oapi::Sketchpad* skp) { return false; }
+	virtual char* ButtonLabel(int bt) { return nullptr; }
+	virtual int ButtonMenu(const struct MFDBUTTONMENU** menu) const { return 0; }
+	virtual bool ConsumeKeyBuffered(DWORD key) { return false; }
+	virtual bool ConsumeButton(int bt, int event) { return false; }
+	void Title(oapi::Sketchpad* skp, const char* title) const {}
+	void InvalidateDisplay() {}
+	DWORD W, H;
+};
+struct MFDBUTTONMENU { const char* line1; const char* line2; char selchar; };
+
+namespace orbiter_stub {
+	struct vessel_values {
+		double	altitude{ 0.0 };
+		double	altitudeGround{ 0.0 };
+		double	pitch{ 0.0 };
+		double	bank{ 0.0 };
+		double	yaw{ 0.0 };
+		double	aoa{ 0.0 };
+		double	mach{ 0.0 };
+		double	airspeed{ 0.0 };
+		double	atmPressure{ 0.0 };
+		double	atmDensity{ 0.0 };
+		double	dynPressure{ 0.0 };
+		VECTOR3	airspeedHorizon{ 0.0, 0.0, 0.0 };
+		VECTOR3	angularVel{ 0.0, 0.0, 0.0 };
+		OBJHANDLE atmRef{ nullptr };
+		double	mainThrust{ 0.0 };
+	};
+
+	inline vessel_values	values;
+	inline size_t			apiCalls = 0;
+	inline std::string		lastLog;
+	inline std::string		scenario;
+	inline ATMCONST			atmConstants{ 101325.0, 1.225, 286.91, 1.4, 0.0, 0.21, 0.0, 0.0, 0.0, { 0.0, 0.0, 0.0 } };
+}
+
+class VESSEL {
+public:
+	VESSEL(OBJHANDLE h, int fm = 1) {}
+	virtual ~VESSEL() {}
+private:
+	mutable UINT stubAnimations_{ 0 };
+public:
+	STUB_CALL double GetAltitude() const { orbiter_stub::apiCalls++; return orbiter_stub::values.altitude; }
+	STUB_CALL double GetAltitude(AltitudeMode mode, int* res = 0) const { orbiter_stub::apiCalls++; return (mode == ALTMODE_GROUND) ? orbiter_stub::values.altitudeGround : orbiter_stub::values.altitude; }
+	STUB_CALL double GetPitch() const { orbiter_stub::apiCalls++; return orbiter_stub::values.pitch; }
+	STUB_CALL double GetBank() const { orbiter_stub::apiCalls++; return orbiter_stub::values.bank; }
+	STUB_CALL double GetYaw() const { orbiter_stub::apiCalls++; return orbiter_stub::values.yaw; }
+	STUB_CALL double GetAOA() const { orbiter_stub::apiCalls++; return orbiter_stub::values.aoa; }
+	STUB_CALL double GetMachNumber() const { orbiter_stub::apiCalls++; return orbiter_stub::values.mach; }
+	STUB_CALL double GetAirspeed() const { orbiter_stub::apiCalls++; return orbiter_stub::values.airspeed; }
+	STUB_CALL double GetAtmPressure() const { orbiter_stub::apiCalls++; return orbiter_stub::values.atmPressure; }
+	STUB_CALL double GetAtmDensity() const { orbiter_stub::apiCalls++; return orbiter_stub::values.atmDensity; }
+	STUB_CALL double GetDynPressure() const { orbiter_stub::apiCalls++; return orbiter_stub::values.dynPressure; }
+	STUB_CALL OBJHANDLE GetAtmRef() const { orbiter_stub::apiCalls++; return orbiter_stub::values.atmRef; }
+	OBJHANDLE GetSurfaceRef() const { return nullptr; }
+	OBJHANDLE GetEquPos(double& lng, double& lat, double& rad) const { return nullptr; }
+	STUB_CALL bool GetAirspeedVector(REFFRAME f, VECTOR3& v) const { orbiter_stub::apiCalls++; v = orbiter_stub::values.airspeedHorizon; return true; }
+	STUB_CALL void GetAngularVel(VECTOR3& v) const { orbiter_stub::apiCalls++; v = orbiter_stub::values.angularVel; }
+	void GetWeightVector(VECTOR3& v) const {}
+	void GetForceVector(VECTOR3& v) const {}
+	double GetMass() const { return 1; }
+	STUB_CALL void GetStatusEx(void* s) const { orbiter_stub::apiCalls++; }
+	STUB_CALL UINT DockingStatus(UINT port) const { orbiter_stub::apiCalls++; return 0; }
+	STUB_CALL bool GroundContact() const { orbiter_stub::apiCalls++; return false; }
+	NAVHANDLE GetNavSource(DWORD n) const { return nullptr; }
+	double GetControlSurfaceLevel(AIRCTRL_TYPE t) const { return 0; }
+	void SetControlSurfaceLevel(AIRCTRL_TYPE t, double l) {}
+	STUB_CALL double GetThrusterGroupLevel(THGROUP_TYPE t) const { orbiter_stub::apiCalls++; return (t == THGROUP_MAIN) ? orbiter_stub::values.mainThrust : 0.0; }
+	STUB_CALL void SetThrusterGroupLevel(THGROUP_TYPE t, double l) { orbiter_stub::apiCalls++; if (t == THGROUP_MAIN) orbiter_stub::values.mainThrust = l; }
+	void SetAttitudeRotLevel(int axis, double l) {}
+	int GetAttitudeMode() const { return 0; }
+	int SetAttitudeMode(int m) const { return 0; }
+	bool ToggleNavmode(int) { return true; }
+	bool ActivateNavmode(int) { return true; }
+	bool DeactivateNavmode(int) { return true; }
+	bool GetNavmodeState(int) { return true; }
+	PROPELLANT_HANDLE CreatePropellantResource(double max, double mass = -1.0, double eff = -1.0) const { return nullptr; }
+	double GetPropellantMass(PROPELLANT_HANDLE) const { return 0; }
+	double GetPropellantMaxMass(PROPELLANT_HANDLE) const { return 1; }
+	void SetPropellantMass(PROPELLANT_HANDLE, double) const {}
+	double GetPropellantFlowrate(PROPELLANT_HANDLE) const { return 0; }
+	THRUSTER_HANDLE CreateThruster(const VECTOR3&, const VECTOR3&, double, PROPELLANT_HANDLE = 0, double = 0.0, double = 0.0, double = 1e5) const { return nullptr; }
+	THGROUP_HANDLE CreateThrusterGroup(THRUSTER_HANDLE*, int, THGROUP_TYPE) const { return nullptr; }
+	void SetThrusterResource(THRUSTER_HANDLE, PROPELLANT_HANDLE) const {}
+	void SetThrusterMax0(THRUSTER_HANDLE, double) const {}
+	UINT AddExhaust(EXHAUSTSPEC*) { return 0; }
+	UINT AddExhaust(THRUSTER_HANDLE, double, double, const VECTOR3&, const VECTOR3&, SURFHANDLE = 0) const { return 0; }
+	void* AddExhaustStream(THRUSTER_HANDLE, const VECTOR3&, PARTICLESTREAMSPEC*) const { return nullptr; }
+	void AddBeacon(BEACONLIGHTSPEC*) {}
+	UINT CreateAnimation(double) const { return stubAnimations_++; }		// Ids are distinct, the vessel keys on them.
+	ANIMATIONCOMPONENT_HANDLE AddAnimationComponent(UINT, double, double, MGROUP_TRANSFORM*, ANIMATIONCOMPONENT_HANDLE = nullptr) const { return nullptr; }
+	bool SetAnimation(UINT, double) const { return true; }
+	UINT AddMesh(MESHHANDLE, const VECTOR3* = 0) const { return 0; }
+	void SetMeshVisibilityMode(UINT, WORD) const {}
+	DEVMESHHANDLE GetDevMesh(VISHANDLE vis, UINT) const { return vis; }
+	void SetSize(double) const {}
+	void SetEmptyMass(double) const {}
+	void SetPMI(const VECTOR3&) const {}
+	void SetCrossSections(const VECTOR3&) const {}
+	void SetRotDrag(const VECTOR3&) const {}
+	void SetDockParams(const VECTOR3&, const VECTOR3&, const VECTOR3&) const {}
+	void SetTouchdownPoints(const TOUCHDOWNVTX*, DWORD) const {}
+	void SetNosewheelSteering(bool) const {}
+	void SetMaxWheelbrakeForce(double) const {}
+	void SetCameraOffset(const VECTOR3&) const {}
+	void SetCameraMovement(const VECTOR3&, double, double, const VECTOR3&, double, double, const VECTOR3&, double, double) const {}
+	void SetCameraDefaultDirection(const VECTOR3&) const {}
+	AIRFOILHANDLE CreateAirfoil3(AIRFOIL_ORIENTATION, const VECTOR3&, void (*)(VESSEL*, double, double, double, void*, double*, double*, double*), void*, double, double, double) const { return nullptr; }
+	CTRLSURFHANDLE CreateControlSurface3(AIRCTRL_TYPE, double, double, const VECTOR3&, int = AIRCTRL_AXIS_AUTO, double = 1.0, UINT = (UINT)-1) const { return nullptr; }
+	bool DelControlSurface(CTRLSURFHANDLE) { return true; }
+	void CreateVariableDragElement(const double*, double, const VECTOR3&) const {}
+	bool Playback() const { return false; }
+	void ParseScenarioLineEx(char*, void*) const {}
+	bool TriggerRedrawArea(int, int, int) { return true; }
+	bool SetPanelBackground(PANELHANDLE, SURFHANDLE*, DWORD, MESHHANDLE, DWORD, DWORD, DWORD = 0, DWORD = 0) const { return true; }
+	bool SetPanelScaling(PANELHANDLE, double, double) const { return true; }
+	int RegisterPanelArea(PANELHANDLE, int, const RECT&, int, int, SURFHANDLE = 0, void* = 0) const { return 0; }
+	int RegisterPanelArea(PANELHANDLE, int, const RECT&, const RECT&, int, int, int) const { return 0; }
+	bool RegisterPanelMFDGeometry(PANELHANDLE, int, int, int) const { return true; }
+	const char* GetName() const { return ""; }
+	OBJHANDLE GetHandle() const { return nullptr; }
+};
+class VESSEL2 : public VESSEL {
+public:
+	using VESSEL::VESSEL;
+	virtual void clbkSetClassCaps(FILEHANDLE cfg) {}
+	virtual void clbkSaveState(FILEHANDLE scn) {}
+	virtual void clbkLoadStateEx(FILEHANDLE scn, void* status) {}
+	virtual void clbkPostCreation() {}
+	virtual void clbkPostStep(double simt, double simdt, double mjd) {}
+	virtual void clbkPreStep(double simt, double simdt, double mjd) {}
+	virtual void clbkVisualCreated(VISHANDLE vis, int refcount) {}
+	virtual void clbkVisualDestroyed(VISHANDLE vis, int refcount) {}
+	virtual bool clbkLoadPanel2D(int id, PANELHANDLE hPanel, DWORD viewW, DWORD viewH) { return false; }
+	virtual bool clbkPanelMouseEvent(int id, int event, int mx, int my) { return false; }
+	virtual bool clbkPanelRedrawEvent(int id, int event, SURFHANDLE surf) { return false; }
+	virtual bool clbkLoadVC(int id) { return false; }
+	virtual bool clbkVCMouseEvent(int id, int event, VECTOR3& p) { return false; }
+	virtual bool clbkVCRedrawEvent(int id, int event, SURFHANDLE surf) { return false; }
+	virtual int clbkConsumeBufferedKey(DWORD key, bool down, char* kstate) { return 0; }
+	virtual void clbkHUDMode(int mode) {}
+	virtual void clbkRCSMode(int mode) {}
+	virtual void clbkNavMode(int mode, bool active) {}
+	virtual void clbkMFDMode(int mfd, int mode) {}
+};
+class VESSEL3 : public VESSEL2 {
+public:
+	using VESSEL2::VESSEL2;
+	virtual bool clbkDrawHUD(int mode, const HUDPAINTSPEC* hps, oapi::Sketchpad* skp) { return true; }
+	virtual bool clbkPanelRedrawEvent(int id, int event, SURFHANDLE surf, void* context) { return false; }
+	virtual bool clbkPanelMouseEvent(int id, int event, int mx, int my, void* context) { return false; }
+};
+class VESSEL4 : public VESSEL3 { public: using VESSEL3::VESSEL3; };
+
+inline char* oapiDebugString() { static char buf[256]; return buf; }
+inline int oapiCockpitMode() { return COCKPIT_VIRTUAL; }
+inline double oapiGetSimTime() { return 0; }
+inline double oapiGetSimStep() { return 0; }
+inline double oapiGetSysTime() { return 0; }
+inline bool oapiTriggerRedrawArea(int, int, int) { return true; }
+inline int oapiEditMeshGroup(MESHHANDLE, DWORD, GROUPEDITSPEC*) { return 0; }
+inline MESHGROUP* oapiMeshGroup(MESHHANDLE, DWORD) { static MESHGROUP g; return &g; }
+inline DWORD oapiAddMeshGroup(MESHHANDLE, MESHGROUP*) { return 0; }
+inline MESHHANDLE oapiLoadMeshGlobal(const char*) { static char mesh; return &mesh; }		// Not null, the vessel code asserts on it.
+inline SURFHANDLE oapiGetTextureHandle(MESHHANDLE, DWORD) { return nullptr; }
+inline bool oapiBlt(SURFHANDLE, SURFHANDLE, int, int, int, int, int, int, DWORD = 0) { return true; }
+inline SURFHANDLE oapiCreateSurface(int, int) { return nullptr; }
+inline int oapiDestroySurface(SURFHANDLE) { return 0; }
+inline void oapiVCRegisterArea(int, int, int) {}
+inline void oapiVCRegisterArea(int, const RECT&, int, int, int, SURFHANDLE) {}
+inline void oapiVCSetAreaClickmode_Spherical(int, const VECTOR3&, double) {}
+inline void oapiVCRegisterMFD(int, const VCMFDSPEC*) {}
+inline void oapiVCRegisterHUD(const VCHUDSPEC*) {}
+inline void oapiSetPanelNeighbours(int, int, int, int) {}
+inline void oapiCameraSetCockpitDir(double, double, bool = false) {}
+inline bool oapiReadScenario_nextline(FILEHANDLE, char*&) { return false; }
+inline void oapiWriteScenario_string(FILEHANDLE, char* item, char* string) { orbiter_stub::scenario += std::string(item) + " " + string + "\n"; }
+inline const ATMCONST* oapiGetPlanetAtmConstants(OBJHANDLE) { return &orbiter_stub::atmConstants; }
+inline void oapiWriteLog(char* line) { orbiter_stub::lastLog = line; }
+inline void oapiWriteLogV(const char* format, ...)
+{
+	char buf[1024];
+	va_list args;
+	va_start(args, format);
+	vsnprintf(buf, sizeof(buf), format, args);
+	va_end(args);
+	orbiter_stub::lastLog = buf;
+}
+inline double oapiGetInducedDrag(double cl, double A, double e) { return cl * cl / (PI * A * e); }
+inline double oapiGetWaveDrag(double M, double M1, double M2, double M3, double cmax)
+{
+	if (M < M1) return 0.0;
+	if (M < M2) return cmax * (M - M1) / (M2 - M1);
+	if (M < M3) return cmax;
+	return cmax * std::sqrt((M3 * M3 - 1.0) / (M * M - 1.0));
+}
+inline int oapiGetMFDMode(int) { return 0; }
+inline void oapiOpenMFD(int, int) {}
+inline void oapiToggleMFD_on(int) {}
+inline bool oapiProcessMFDButton(int, int, int) { return true; }
+inline bool oapiSendMFDKey(int, DWORD) { return true; }
+inline void oapiRefreshMFDButtons(int, OBJHANDLE = 0) {}
+inline const char* oapiMFDButtonLabel(int, int) { return nullptr; }
+inline int oapiRegisterMFDMode(MFDMODESPECEX&) { return 0; }
+inline bool oapiUnregisterMFDMode(int) { return true; }
+inline int oapiGetHUDMode() { return 0; }
+inline bool oapiSetHUDMode(int) { return true; }
+inline oapi::Font* oapiCreateFont(int, bool, const char*, int = 0, int = 0) { return nullptr; }
+inline void oapiReleaseFont(oapi::Font*) {}
+inline DWORD oapiGetNavType(NAVHANDLE) { return 0; }
+inline bool oapiGetNavData(NAVHANDLE, NAVDATA*) { return true; }
+inline void oapiGetNavPos(NAVHANDLE, VECTOR3*) {}
+inline void oapiGlobalToEqu(OBJHANDLE, const VECTOR3&, double*, double*, double*) {}
+inline double oapiGetSize(OBJHANDLE) { return 1; }
+inline int oapiRegisterPanelArea(int, const RECT&, int = 0, int = 0, int = 0) { return 0; }
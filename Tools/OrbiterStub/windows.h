@@ -0,0 +1,69 @@
+//	windows - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// The Win32 types and macros the Orbiter SDK stand-in and the sources need.
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+typedef unsigned int	UINT;
+typedef unsigned long	DWORD;
+typedef unsigned short	WORD;
+typedef int				BOOL;
+typedef void*			HINSTANCE;
+typedef void*			HWND;
+typedef uintptr_t		WPARAM;
+typedef intptr_t		LPARAM;
+typedef void*			HANDLE;
+
+struct RECT { long left, top, right, bottom; };
+#define TRUE 1
+#define FALSE 0
+#define LOWORD(l) ((WORD)(((uintptr_t)(l)) & 0xffff))
+#define HIWORD(l) ((WORD)((((uintptr_t)(l)) >> 16) & 0xffff))
+
+using std::isnan; using std::signbit; using std::abs;
+
+// The Windows headers define these as macros.
+template<class A, class B> inline auto max(A a, B b) -> decltype(a + b) { return a > b ? a : b; }
+template<class A, class B> inline auto min(A a, B b) -> decltype(a + b) { return a < b ? a : b; }
+
+// Both forms of the CRT's sprintf_s, the buffer size given or taken from the array.
+inline int sprintf_s(char* buffer, size_t size, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	auto n = vsnprintf(buffer, size, format, args);
+	va_end(args);
+	return n;
+}
+
+template<size_t N> inline int sprintf_s(char (&buffer)[N], const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	auto n = vsnprintf(buffer, N, format, args);
+	va_end(args);
+	return n;
+}
+
+#define sscanf_s sscanf
@@ -0,0 +1,258 @@
+//	PowerBusCheck - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Runs two copies of an electrical_network (electrical_network.h) through a scripted power-up:
+// battery, external power, a tied bus with a breaker, the fuel cell coming up, consumers flipping,
+// a breaker trip and shutdown.  In one copy the switchable consumers report_draw, in the other they
+// are all polled.  Every step the bus loads and volts must match, and changed_consumers must name
+// exactly the reporting consumers whose draw changed.  Then times a step of a bus with 500
+// consumers each way.  Built against the SDK stand-in in Tools/OrbiterStub:
+//
+//	g++ -std=c++20 -O2 -I../OrbiterStub -I../../bc_orbiter PowerBusCheck.cpp -o PowerBusCheck
+//	cl /std:c++20 /O2 /EHsc /I..\OrbiterStub /I..\..\bc_orbiter PowerBusCheck.cpp
+//
+//	PowerBusCheck [consumers]	Steps checked and the largest load difference, then ns per step
+//								each way, default 500 consumers.  Exits 1 on any mismatch, a load
+//								difference over 1e-9 amps is one.
+
+#include "electrical_network.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	const double DT = 0.02;
+
+	/**
+	consumer
+	Draws its amps while switched on and the bus is up, scaled by the bus volts like a resistive load.
+	*/
+	struct consumer : public bco::power_consumer
+	{
+		bco::power_provider*	bus{ nullptr };
+		double					amps{ 0.0 };
+		double					volts{ 0.0 };
+		bool					on{ false };
+		bool					reports{ false };
+
+		void on_change(double v) override { volts = v; }
+		double amp_draw() const override { return (on && (volts > 20.0)) ? amps * volts / 28.0 : 0.0; }
+		bool reports_draw() const override { return reports; }
+
+		void set_on(bool o) {
+			if (on == o) return;
+			on = o;
+			if (reports) bus->draw_changed(this);
+		}
+	};
+
+	/**
+	rig
+	The buses and sources of the power system, MAIN with external, fuel cell and battery, and AUX tied
+	to it behind a breaker.
+	*/
+	struct rig
+	{
+		bco::electrical_network	network{ 24.0 };
+		bco::electrical_bus&	main;
+		bco::electrical_bus&	aux;
+		size_t					external;
+		size_t					fuelCell;
+		size_t					battery;
+		size_t					tie;
+
+		std::vector<std::unique_ptr<consumer>>	consumers;
+		std::vector<double>						lastDraw;
+
+		// Switchable consumers report their draw if 'reporting', every fourth is always polled.
+		rig(size_t count, bool reporting) :
+			main(network.add_bus("MAIN")),
+			aux(network.add_bus("AUX", 25.0))
+		{
+			external = network.add_source(main);
+			fuelCell = network.add_source(main);
+			battery = network.add_battery(main, 40.0, 28.0, 5.0);
+			tie = network.add_tie(main, aux);
+
+			std::mt19937 rng(5);
+			std::uniform_real_distribution<double> amps(0.1, 4.0);
+			for (size_t i = 0; i < count; i++) {
+				auto c = std::make_unique<consumer>();
+				c->amps = amps(rng);
+				c->reports = reporting && ((i % 4) != 3);
+				c->bus = (i % 3 == 2) ? &aux : &main;
+				c->bus->attach_consumer(c.get());
+				consumers.push_back(std::move(c));
+			}
+			lastDraw.resize(count, 0.0);
+		}
+	};
+
+	bool failed = false;
+	double worstLoad = 0.0;
+	size_t steps = 0;
+
+	void fail(const char* what, size_t step)
+	{
+		if (!failed) fprintf(stderr, "step %zu: %s\n", step, what);
+		failed = true;
+	}
+
+	// What update_load will read this step, then the step itself on both rigs, then the comparison.
+	void step(rig& inc, rig& pol)
+	{
+		std::vector<bco::power_consumer*> expected;
+		for (size_t i = 0; i < inc.consumers.size(); i++) {
+			auto& c = *inc.consumers[i];
+			auto draw = c.amp_draw();
+			if (c.reports && (draw != inc.lastDraw[i])) expected.push_back(&c);
+			inc.lastDraw[i] = draw;
+		}
+
+		inc.network.step(DT);
+		pol.network.step(DT);
+		steps++;
+
+		bco::electrical_bus* incBuses[] = { &inc.main, &inc.aux };
+		bco::electrical_bus* polBuses[] = { &pol.main, &pol.aux };
+		std::vector<bco::power_consumer*> changed;
+		for (int b = 0; b < 2; b++) {
+			auto d = std::fabs(incBuses[b]->amp_load() - polBuses[b]->amp_load());
+			worstLoad = std::max(worstLoad, d);
+			if (d > 1e-9) fail("incremental load differs from polled", steps);
+			if (incBuses[b]->volts_available() != polBuses[b]->volts_available()) fail("bus volts differ", steps);
+			if (incBuses[b]->is_tripped() != polBuses[b]->is_tripped()) fail("breaker state differs", steps);
+			if (!polBuses[b]->changed_consumers().empty()) fail("polled bus reports changed consumers", steps);
+			changed.insert(changed.end(), incBuses[b]->changed_consumers().begin(), incBuses[b]->changed_consumers().end());
+		}
+
+		std::sort(changed.begin(), changed.end());
+		std::sort(expected.begin(), expected.end());
+		if (changed != expected) fail("changed_consumers is not the set of reporting consumers that changed", steps);
+	}
+
+	// Apply 'f' to both rigs, then step a few frames.
+	template<typename F>
+	void event(rig& inc, rig& pol, F f, int frames = 3)
+	{
+		f(inc);
+		f(pol);
+		for (int i = 0; i < frames; i++) step(inc, pol);
+	}
+
+	void power_up(size_t count)
+	{
+		rig inc(count, true);
+		rig pol(count, false);
+		auto n = inc.consumers.size();
+
+		// Consumers switched in the same order on both rigs.
+		auto flip = [](size_t from, size_t to, size_t every, bool on) {
+			return [=](rig& r) { for (size_t i = from; i < to; i += every) r.consumers[i]->set_on(on); };
+		};
+
+		event(inc, pol, [](rig& r) {}, 2);												// Cold and dark.
+		event(inc, pol, flip(0, n, 5, true));											// Switches set before power.
+		event(inc, pol, [](rig& r) { r.network.set_source_connected(r.battery, true); });
+		event(inc, pol, flip(1, n / 2, 2, true));
+		event(inc, pol, [](rig& r) { r.network.set_source_volts(r.external, 28.0); r.network.set_source_connected(r.external, true); });
+		event(inc, pol, [](rig& r) { r.network.set_tie(r.tie, true); });
+		event(inc, pol, flip(n / 2, n, 3, true));
+
+		// The fuel cell comes up over a few seconds while external power is still on.
+		event(inc, pol, [](rig& r) { r.network.set_source_connected(r.fuelCell, true); }, 1);
+		for (int i = 1; i <= 150; i++) {
+			event(inc, pol, [i](rig& r) { r.network.set_source_volts(r.fuelCell, 28.0 * i / 150.0); }, 1);
+		}
+		event(inc, pol, [](rig& r) { r.network.set_source_connected(r.external, false); });
+
+		// Cruise, a few consumers flipped every frame.
+		std::mt19937 rng(9);
+		std::uniform_int_distribution<size_t> pick(0, n - 1);
+		for (int f = 0; f < 500; f++) {
+			auto a = pick(rng);
+			auto b = pick(rng);
+			event(inc, pol, [a, b](rig& r) { r.consumers[a]->set_on(!r.consumers[a]->on); r.consumers[b]->set_on(!r.consumers[b]->on); }, 1);
+		}
+
+		// AUX cleared, then everything on it at once trips its breaker, then off again and the breaker reset.
+		event(inc, pol, flip(2, n, 3, false));
+		event(inc, pol, [](rig& r) { r.aux.reset_breaker(); });
+		if (inc.aux.is_tripped()) fail("AUX breaker tripped with nothing on", steps);
+		event(inc, pol, flip(2, n, 3, true));
+		if (!inc.aux.is_tripped()) fail("AUX breaker did not trip", steps);
+		event(inc, pol, flip(2, n, 3, false));
+		event(inc, pol, [](rig& r) { r.aux.reset_breaker(); });
+
+		// Fuel cell fails onto the battery, then shutdown.
+		event(inc, pol, [](rig& r) { r.network.set_source_volts(r.fuelCell, 12.0); });
+		event(inc, pol, flip(0, n, 1, false));
+		event(inc, pol, [](rig& r) { r.network.set_source_connected(r.battery, false); r.network.set_source_connected(r.fuelCell, false); });
+	}
+
+	void bench(size_t count)
+	{
+		const int FRAMES = 20000;
+
+		auto time = [&](const char* name, bool reporting) {
+			rig r(count, reporting);
+			r.network.set_source_volts(r.external, 28.0);
+			r.network.set_source_connected(r.external, true);
+			r.network.set_tie(r.tie, true);
+			for (size_t i = 0; i < count; i += 2) r.consumers[i]->set_on(true);
+			r.network.step(DT);
+			r.network.step(DT);
+
+			// One switch flip every ten frames, a busy cockpit.
+			std::mt19937 rng(3);
+			std::uniform_int_distribution<size_t> pick(0, count - 1);
+			auto start = std::chrono::steady_clock::now();
+			for (int f = 0; f < FRAMES; f++) {
+				if (f % 10 == 0) {
+					auto& c = *r.consumers[pick(rng)];
+					c.set_on(!c.on);
+				}
+				r.network.step(DT);
+			}
+			std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+			printf("  %-10s %10.1f ns per step\n", name, ns.count() / FRAMES);
+		};
+
+		printf("%zu consumers, a quarter always polled:\n", count);
+		time("polled", false);
+		time("reporting", true);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	size_t count = (argc > 1) ? atoi(argv[1]) : 500;
+
+	power_up(40);
+	printf("%zu power-up steps, largest load difference %.3g A\n", steps, worstLoad);
+	if (failed) return 1;
+
+	bench(count);
+	return 0;
+}
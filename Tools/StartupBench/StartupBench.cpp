@@ -0,0 +1,280 @@
+//	StartupBench - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Times vessel startup, the SR71Vessel constructor (every AddComponent/AddControl) and
+// clbkSetClassCaps, for the full SR71Vessel compiled from the SR71R sources.  Built twice: as is the
+// handlers are registered by the parts' own types (interfaces found at compile time), with
+// BCO_RUNTIME_REGISTRATION defined every part is registered with dynamic_cast, as before.  Both
+// builds must print the same fingerprint, the API calls and saved scenario after every event id is
+// clicked and a step run.  Built against the SDK stand-in in Tools/OrbiterStub, with the sources
+// listed in SR71R.vcxproj:
+//
+//	SRC=$(sed -n 's#.*ClCompile Include="\(.*\)".*#../../SR71R/\1#p' ../../SR71R/SR71R.vcxproj)
+//	g++ -std=c++20 -O2 -I../OrbiterStub -I../../bc_orbiter -I../../SR71R StartupBench.cpp $SRC -o StartupBench
+//	g++ -std=c++20 -O2 -DBCO_RUNTIME_REGISTRATION -I../OrbiterStub -I../../bc_orbiter -I../../SR71R StartupBench.cpp $SRC -o StartupBenchRtti
+//	cl /std:c++20 /O2 /EHsc /I..\OrbiterStub /I..\..\bc_orbiter /I..\..\SR71R StartupBench.cpp <the same sources>
+//
+//	StartupBench				Fingerprint and us per SR71Vessel startup for this build.
+//	StartupBench --synthetic [parts]	Generic buttons, levers, gauges and subsystems, default 400 parts,
+//								registered both ways in one build.  Exits 1 if the two ways, or the
+//								subsystems passed typed as a base with only some of their handlers,
+//								register different handlers.
+
+#include "SR71Vessel.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	const int VESSELS = 500;
+
+#ifdef BCO_RUNTIME_REGISTRATION
+	const char* REGISTRATION = "run time (dynamic_cast)";
+#else
+	const char* REGISTRATION = "compile time";
+#endif
+
+	// Every event id clicked, a step, then the vessel's scenario lines.
+	void fingerprint()
+	{
+		const int MAX_ID = 1000;
+
+		auto v = std::make_unique<SR71Vessel>(nullptr, 1);
+		v->clbkSetClassCaps(nullptr);
+		v->clbkLoadVC(0);
+
+		auto calls = orbiter_stub::apiCalls;
+		VECTOR3 p{ 0.0, 0.0, 0.0 };
+		for (int id = 0; id <= MAX_ID; id++) {
+			v->clbkVCMouseEvent(id, PANEL_MOUSE_LBDOWN, p);
+			v->clbkPanelMouseEvent(id, PANEL_MOUSE_LBDOWN, 0, 0);
+		}
+		v->clbkPostStep(1.0, 0.02, 0.0);
+		calls = orbiter_stub::apiCalls - calls;
+
+		orbiter_stub::scenario.clear();
+		v->clbkSaveState(nullptr);
+
+		uint32_t hash = 2166136261u;		// FNV-1a
+		for (auto c : orbiter_stub::scenario) hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+		printf("Fingerprint: %zu API calls, scenario %zu bytes, hash %08x\n", calls, orbiter_stub::scenario.size(), hash);
+	}
+
+	void time_vessel()
+	{
+		std::chrono::duration<double, std::micro> total{ 0 };
+		for (int i = 0; i < VESSELS; i++) {
+			auto start = std::chrono::steady_clock::now();
+			{
+				SR71Vessel v(nullptr, 1);
+				v.clbkSetClassCaps(nullptr);
+			}
+			total += std::chrono::steady_clock::now() - start;
+		}
+		printf("  SR71Vessel, %-24s %8.2f us per vessel\n", REGISTRATION, total.count() / VESSELS);
+	}
+
+	// The synthetic parts, both ways in one build.
+	namespace synthetic {
+
+		struct counts {
+			size_t	events{ 0 };
+			size_t	steps{ 0 };
+			size_t	loads{ 0 };
+			size_t	caps{ 0 };
+			bool operator==(const counts&) const = default;
+		};
+
+		counts seen;
+
+		struct button :
+			  public bco::control
+			, public bco::vc_event_target
+			, public bco::panel_event_target
+		{
+			bool on_event(int id, int event) override { seen.events++; return true; }
+		};
+
+		struct lever :
+			  public bco::control
+			, public bco::vc_animation
+			, public bco::vc_event_target
+		{
+			bco::animation_group	group{ { 1, 2 }, _V(0.0, 0.0, 0.0), _V(1.0, 0.0, 0.0), 1.0, 0.0, 1.0 };
+
+			bco::animation_group* vc_animation_group() override { return &group; }
+			double vc_animation_speed() const override { return 1.0; }
+			bool on_event(int id, int event) override { seen.events++; return true; }
+		};
+
+		struct gauge :
+			  public bco::control
+			, public bco::panel_animation
+			, public bco::vc_tex_animation
+		{
+			void panel_step(MESHHANDLE mesh, double simdt) override {}
+			int panel_id() override { return 0; }
+			void vc_step(DEVMESHHANDLE mesh, double simdt) override {}
+		};
+
+		struct stepper :
+			  public bco::vessel_component
+			, public bco::post_step
+		{
+			void handle_post_step(bco::vessel& vessel, double simt, double simdt, double mjd) override { seen.steps++; }
+		};
+
+		// A stepper that adds handlers, for a pointer typed as the base that implements only some of them.
+		struct subsystem :
+			  public stepper
+			, public bco::set_class_caps
+			, public bco::load_vc
+		{
+			void handle_set_class_caps(bco::vessel& vessel) override { seen.caps++; }
+			bool handle_load_vc(bco::vessel& vessel, int vcid) override { seen.loads++; return true; }
+		};
+
+		struct bench_vessel : public bco::vessel
+		{
+			bench_vessel() : bco::vessel(nullptr, 1) {}
+		};
+
+		struct parts {
+			std::vector<button>	buttons;
+			std::vector<lever>	levers;
+			std::vector<gauge>	gauges;
+			std::vector<subsystem>	systems;
+
+			explicit parts(int count) : buttons(count / 2), levers(count / 4), gauges(count / 8), systems(count / 8) {}
+
+			// Controls keep the id they are given, start each vessel from unassigned ids.
+			void reset_ids()
+			{
+				for (auto& c : buttons) c.set_id(-1);
+				for (auto& c : levers) c.set_id(-1);
+				for (auto& c : gauges) c.set_id(-1);
+			}
+		};
+
+		void add_typed(bco::vessel& v, parts& p)
+		{
+			for (auto& c : p.buttons) v.AddControl(&c);
+			for (auto& c : p.levers) v.AddControl(&c);
+			for (auto& c : p.gauges) v.AddControl(&c);
+			for (auto& c : p.systems) v.AddComponent(&c);
+		}
+
+		void add_partial(bco::vessel& v, parts& p)
+		{
+			for (auto& c : p.buttons) v.AddControl(&c);
+			for (auto& c : p.levers) v.AddControl(&c);
+			for (auto& c : p.gauges) v.AddControl(&c);
+			for (auto& c : p.systems) v.AddComponent(static_cast<stepper*>(&c));
+		}
+
+		void add_base(bco::vessel& v, parts& p)
+		{
+			std::vector<bco::control*> controls;
+			std::vector<bco::vessel_component*> components;
+			for (auto& c : p.buttons) controls.push_back(&c);
+			for (auto& c : p.levers) controls.push_back(&c);
+			for (auto& c : p.gauges) controls.push_back(&c);
+			for (auto& c : p.systems) components.push_back(&c);
+
+			for (auto c : controls) v.AddControl(c);
+			for (auto c : components) v.AddComponent(c);
+		}
+
+		// What a vessel does with every event id, one post step and a VC load.
+		counts exercise(bco::vessel& v, int ids)
+		{
+			seen = {};
+			v.clbkSetClassCaps(nullptr);
+			VECTOR3 p{ 0.0, 0.0, 0.0 };
+			for (int id = 0; id <= ids; id++) {
+				v.clbkVCMouseEvent(id, PANEL_MOUSE_LBDOWN, p);
+				v.clbkPanelMouseEvent(id, PANEL_MOUSE_LBDOWN, 0, 0);
+			}
+			v.clbkPostStep(1.0, 0.02, 0.0);
+			v.clbkLoadVC(0);
+			return seen;
+		}
+
+		int run(int count)
+		{
+			parts p(count);
+
+			auto a = std::make_unique<bench_vessel>();
+			add_typed(*a, p);
+			auto typed = exercise(*a, count);
+
+			p.reset_ids();
+			auto b = std::make_unique<bench_vessel>();
+			add_base(*b, p);
+			auto base = exercise(*b, count);
+
+			p.reset_ids();
+			auto c = std::make_unique<bench_vessel>();
+			add_partial(*c, p);
+			auto partial = exercise(*c, count);
+
+			if (!(typed == base) || !(typed == partial)) {
+				fprintf(stderr, "typed %zu/%zu/%zu/%zu, base %zu/%zu/%zu/%zu, partial %zu/%zu/%zu/%zu events/steps/loads/caps\n",
+					typed.events, typed.steps, typed.loads, typed.caps, base.events, base.steps, base.loads, base.caps,
+					partial.events, partial.steps, partial.loads, partial.caps);
+				return 1;
+			}
+
+			auto time = [&](const char* name, auto add) {
+				std::chrono::duration<double, std::micro> total{ 0 };
+				for (int i = 0; i < VESSELS; i++) {
+					p.reset_ids();
+					auto start = std::chrono::steady_clock::now();
+					{
+						bench_vessel v;
+						add(v, p);
+						v.clbkSetClassCaps(nullptr);
+					}
+					total += std::chrono::steady_clock::now() - start;
+				}
+				printf("  %-14s %8.2f us per vessel\n", name, total.count() / VESSELS);
+			};
+
+			printf("%d synthetic parts (%zu events, %zu steps, %zu loads)\n", count, typed.events, typed.steps, typed.loads);
+			time("dynamic_cast", add_base);
+			time("compile time", add_typed);
+			return 0;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if ((argc > 1) && (strcmp(argv[1], "--synthetic") == 0)) {
+		return synthetic::run((argc > 2) ? atoi(argv[2]) : 400);
+	}
+
+	fingerprint();
+	time_vessel();
+	return 0;
+}
@@ -0,0 +1,219 @@
+//	TextBench - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+// Counts the blits text_renderer makes per string against drawing a character at a time the way
+// DrawSurfaceText does, and checks both give the same pixels.  Surfaces are plain pixel arrays
+// standing in for the Orbiter blit calls.  Standalone, no Orbiter headers:
+//
+//	g++ -std=c++20 -O2 -I../../bc_orbiter TextBench.cpp -o TextBench
+//	cl /std:c++20 /O2 /EHsc /I..\..\bc_orbiter TextBench.cpp
+//
+//	TextBench			Blits per string and time per string for each workload.  Exits 1 if the renderer
+//						draws different pixels, fixed width against DrawSurfaceText and proportional
+//						cached against uncached, or if it makes more blits than the glyph runs alone.
+
+#include "text_renderer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace bco = bc_orbiter;
+
+namespace {
+
+	struct surface {
+		int						w;
+		int						h;
+		std::vector<uint32_t>	px;
+	};
+
+	size_t blits = 0;
+
+	struct test_surfaces
+	{
+		using handle = surface*;
+
+		static void blit(handle target, handle source, int tx, int ty, int sx, int sy, int w, int h)
+		{
+			blits++;
+			for (int j = 0; j < h; j++) {
+				for (int i = 0; i < w; i++) {
+					auto x = tx + i;
+					auto y = ty + j;
+					if ((x < 0) || (y < 0) || (x >= target->w) || (y >= target->h)) continue;
+					target->px[y * target->w + x] = source->px[(sy + j) * source->w + sx + i];
+				}
+			}
+		}
+
+		static handle create(int w, int h) { return new surface{ w, h, std::vector<uint32_t>(w * h, 0xdeadbeef) }; }
+		static void destroy(handle s) { delete s; }
+	};
+
+	using renderer = bco::basic_text_renderer<test_surfaces>;
+
+	constexpr int CHAR_W = 12;
+	constexpr int CHAR_H = 20;
+	constexpr int SOURCE_X = 4;
+	constexpr int SOURCE_Y = 2;
+	constexpr int BLANK_X = 1600;
+	constexpr int BLANK_Y = 2;
+
+	// DrawSurfaceText and DrawBlankText (Tools.h) as they draw an MFD label, one blit per character.
+	void draw_reference(surface* target, surface* font, int x, int y, const char* text)
+	{
+		test_surfaces::blit(target, font, x - 20, y, BLANK_X, BLANK_Y, 3 * CHAR_W, CHAR_H);
+
+		auto len = static_cast<int>(strlen(text));
+		auto xCurrent = x - (len * CHAR_W) / 2;
+		test_surfaces::blit(target, font, xCurrent, y, BLANK_X, BLANK_Y, len * CHAR_W, CHAR_H);
+		for (int i = 0; i < len; i++) {
+			int l = text[i] - 32;
+			if (l >= 0) {
+				test_surfaces::blit(target, font, xCurrent, y, (l * CHAR_W) + SOURCE_X, SOURCE_Y, CHAR_W, CHAR_H);
+				xCurrent += CHAR_W;
+			}
+		}
+	}
+
+	struct workload {
+		const char*					name;
+		std::vector<std::string>	strings;
+	};
+
+	std::vector<workload> workloads()
+	{
+		std::vector<workload> w;
+
+		// Labels of a few stock MFD modes, redrawn as the modes are cycled.
+		w.push_back({ "mfd labels", {
+			"MOD", "TGT", "FRM", "PRJ", "REF", "SEL", "", "", "", "", "", "",
+			"HUD", "ZM+", "ZM-", "DST", "TRG", "DSP", "ALT", "INC", "", "", "", "",
+			"TGT", "UNI", "FRM", "MOD", "REF", "AP", "PRG", "DST", "", "", "", "" } });
+
+		// Status lines that change every few frames.
+		std::vector<std::string> lines;
+		for (int i = 0; i < 120; i++) {
+			char buf[32];
+			snprintf(buf, sizeof(buf), "ALT %05d", 80000 + (i / 4) * 10);
+			lines.push_back(buf);
+			snprintf(buf, sizeof(buf), "HDG %03d", (i / 8) % 360);
+			lines.push_back(buf);
+		}
+		w.push_back({ "status lines", lines });
+
+		// Every string different, the worst case for the cache.
+		std::vector<std::string> unique;
+		for (int i = 0; i < 2000; i++) unique.push_back(std::to_string(100000 + i * 7));
+		w.push_back({ "unique numbers", unique });
+
+		return w;
+	}
+
+	bool check_pixels(surface& font)
+	{
+		const char* labels[] = { "", "A", "UP", "MOD", "NXT", "ABC", "123", "x y", "MOD", "UP" };
+		renderer r(512, 512, 64);
+		r.set_font(&font, bco::font_face::fixed(SOURCE_X, SOURCE_Y, CHAR_W, CHAR_H, BLANK_X, BLANK_Y));
+
+		// Three passes: drawn directly, given a cell, then from the cell.
+		for (int pass = 0; pass < 3; pass++) {
+			for (auto l : labels) {
+				surface a{ 120, 40, std::vector<uint32_t>(120 * 40, 7) };
+				auto b = a;
+				draw_reference(&a, &font, 50, 10, l);
+				r.draw(&b, 50, 10, l, bco::text_align::center, { -20, 3 * CHAR_W });
+				if (a.px != b.px) {
+					fprintf(stderr, "pixel difference drawing '%s'\n", l);
+					return false;
+				}
+			}
+		}
+
+		// Proportional glyphs, every alignment: the cached draw must match blitting the layout directly.
+		auto face = bco::font_face::fixed(SOURCE_X, SOURCE_Y, CHAR_W, CHAR_H, BLANK_X, BLANK_Y);
+		for (auto& g : face.glyphs) g.width = 4 + (g.x % 9);
+		r.set_font(&font, face);
+
+		for (auto align : { bco::text_align::left, bco::text_align::center, bco::text_align::right }) {
+			for (auto l : { "Wide", "ill", "Mixed 42", "" }) {
+				surface a{ 160, 40, std::vector<uint32_t>(160 * 40, 7) };
+				auto b = a;
+				auto layout = bco::text_layout::make(face, l, align, { -30, 60 });
+				for (auto& run : layout.runs) test_surfaces::blit(&a, &font, 80 + run.x, 10, run.sx, run.sy, run.width, CHAR_H);
+				r.draw(&b, 80, 10, l, align, { -30, 60 });
+				r.draw(&b, 80, 10, l, align, { -30, 60 });
+				r.draw(&b, 80, 10, l, align, { -30, 60 });
+				if (a.px != b.px) {
+					fprintf(stderr, "pixel difference drawing '%s' proportional\n", l);
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// False if the cache costs blits over drawing the glyph runs directly.
+	bool run(const workload& w, surface& font, surface& target)
+	{
+		const int passes = 50;
+		auto face = bco::font_face::fixed(SOURCE_X, SOURCE_Y, CHAR_W, CHAR_H, BLANK_X, BLANK_Y);
+		auto count = static_cast<double>(w.strings.size() * passes);
+
+		auto measure = [&](const char* how, auto draw) {
+			blits = 0;
+			auto start = std::chrono::steady_clock::now();
+			for (int p = 0; p < passes; p++) {
+				for (auto& s : w.strings) draw(s.c_str());
+			}
+			std::chrono::duration<double, std::micro> us = std::chrono::steady_clock::now() - start;
+			printf("  %-14s %6.2f blits  %8.3f us per string\n", how, blits / count, us.count() / count);
+			return blits / count;
+		};
+
+		printf("%s (%zu strings)\n", w.name, w.strings.size());
+
+		measure("per character", [&](const char* s) { draw_reference(&target, &font, 400, 100, s); });
+
+		auto runs = measure("glyph runs", [&](const char* s) {
+			auto l = bco::text_layout::make(face, s, bco::text_align::center, { -20, 3 * CHAR_W });
+			for (auto& run : l.runs) test_surfaces::blit(&target, &font, 400 + run.x, 100, run.sx, run.sy, run.width, CHAR_H);
+		});
+
+		renderer r(512, 512, 128);
+		r.set_font(&font, face);
+		auto cached = measure("cached", [&](const char* s) { r.draw(&target, 400, 100, s, bco::text_align::center, { -20, 3 * CHAR_W }); });
+		if (cached > runs) fprintf(stderr, "%s: the cache makes more blits than it saves\n", w.name);
+		return cached <= runs;
+	}
+}
+
+int main()
+{
+	surface font{ 2048, 64, std::vector<uint32_t>(2048 * 64) };
+	for (size_t i = 0; i < font.px.size(); i++) font.px[i] = static_cast<uint32_t>(i * 2654435761u);
+
+	if (!check_pixels(font)) return 1;
+
+	surface target{ 800, 200, std::vector<uint32_t>(800 * 200) };
+	auto ok = true;
+	for (auto& w : workloads()) ok = run(w, font, target) && ok;
+	return ok ? 0 : 1;
+}
@@ -18,6 +18,7 @@
 
 #include "OrbiterAPI.h"
 #include "IAnimationState.h"
+#include "delegate.h"
 
 #include <vector>
 #include <functional>
@@ -67,7 +68,7 @@ namespace bc_orbiter
         a lot of virtual function calls in the 'Step' loop.
     */
 
-    using func_target_achieved = std::function<void()>;
+    using func_target_achieved = delegate<void()>;
 
     struct state_update
     {
@@ -212,9 +213,17 @@ namespace bc_orbiter
     };
 
     struct animation {
+        virtual ~animation() = default;     // vessel owns them as animation.
         virtual void Step(double dt) = 0;
         virtual double GetState() const = 0;
         virtual void SetState(double) = 0;
+
+        /**
+        IsAtRest
+        True when the animation has reached its target and the last state has been stepped
+        out.  A resting animation does not need to be stepped until this returns false again.
+        */
+        virtual bool IsAtRest() const = 0;
     };
 
     /**
@@ -248,6 +257,7 @@ namespace bc_orbiter
         */
         void Step(double target, double dt)
         {
+            stateSet_ = false;
             updateState_.target_state_ = target;
             if (T::update_state(updateState_, dt))
             {
@@ -260,6 +270,7 @@ namespace bc_orbiter
 
         void Step(double dt) override
         {
+            stateSet_ = false;
             updateState_.target_state_ = stateProvider_->GetState();
             if (T::update_state(updateState_, dt))
             {
@@ -281,6 +292,22 @@ namespace bc_orbiter
         {
             updateState_.state_ = state;
             updateState_.target_state_ = state;
+            stateSet_ = true;
+        }
+
+        /**
+        IsAtRest
+        @param target The target the animation would be stepped towards.
+        Returns true if the state is already at target and has not been set directly since the last Step.
+        */
+        bool IsAtRest(double target) const
+        {
+            return !stateSet_ && (target == updateState_.state_);
+        }
+
+        bool IsAtRest() const override
+        {
+            return IsAtRest((nullptr == stateProvider_) ? updateState_.target_state_ : stateProvider_->GetState());
         }
 
         /**
@@ -324,6 +351,7 @@ namespace bc_orbiter
         func_target_achieved  funcTarget_;
         IAnimationState*    stateProvider_{ nullptr };
         UINT                vesselId_{ 0 };
+        bool                stateSet_{ true };      // Forces at least one Step after SetState.
     };
 
     /* animation_target
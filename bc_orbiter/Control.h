@@ -26,6 +26,7 @@ namespace bc_orbiter
 #include "Animation.h"
 #include "Tools.h"
 #include "signals.h"
+#include "redraw_queue.h"
 
 #include <vector>
 #include <functional>
@@ -38,12 +39,14 @@ namespace bc_orbiter {
 	The implementing class will provide the group to animate, as well as the speed.  It
 	will also implement the actual step that will update the animation.  The presence of 
 	this base class instructs vessel to add it to a collection that will be called during
-	the VC step.
+	the VC step.  Override vc_at_rest to let vessel skip the step while the animation
+	has nothing to do.
 	*/
 	struct vc_animation {
 		virtual animation_group*		vc_animation_group() = 0;
 		virtual double				vc_animation_speed() const = 0;
 		virtual double				vc_step(double simdt) { return 0.0; }
+		virtual bool				vc_at_rest() const { return false; }
 	};
 
 	/**
@@ -107,17 +110,24 @@ namespace bc_orbiter {
 	struct power_consumer {
 		virtual void on_change(double v) { };  // A class that has a time step may not need change notification.
 		virtual double amp_draw() const = 0;
+
+		// Return true if the consumer calls power_provider::draw_changed whenever amp_draw changes for a reason
+		// other than a volts change.  The provider then only re-reads amp_draw when told to instead of every step.
+		virtual bool reports_draw() const { return false; }
 	};
 
 	struct power_provider {
 		virtual void attach_consumer(power_consumer* consumer) = 0;
 		virtual double volts_available() const = 0;
 		virtual double amp_load() const = 0;
+
+		// Called by a consumer that reports_draw when its amp_draw may have changed.
+		virtual void draw_changed(power_consumer* consumer) = 0;
 	};
 
 	struct one_way_switch {
 		virtual bool is_on() const = 0;
-		virtual void attach_on_change(const std::function<void()>& func) = 0;
+		virtual void attach_on_change(const delegate<void()>& func) = 0;
 	};
 
 	/**
@@ -131,6 +141,9 @@ namespace bc_orbiter {
 		
 		// Removes 'amount' from the tank, returns the amount actually drawn.
 		virtual double draw(double amount) = 0;
+
+		// Continuous draw in units per second, integrated by the tank over each of its steps.
+		virtual void set_draw_rate(double perSecond) = 0;
 	};
 
 	struct hydraulic_provider {
@@ -172,7 +185,26 @@ namespace bc_orbiter {
         virtual void set_id(int id) { ctrlId_ = id; }
         virtual int get_id() const { return ctrlId_; }
 
+        /**
+        Set by vessel::AddControl, the redraw queue of the vessel the control belongs to.
+        */
+        void set_redraw_queue(redraw_queue* queue) { redraws_ = queue; }
+
+    protected:
+        /**
+        Queue a redraw of this control's area with its vessel.  Nothing is queued before the control
+        is added to a vessel, the vessel redraws everything when its visuals load.
+        */
+        void request_redraw(int pnlId) {
+            if (redraws_) redraws_->request(pnlId, get_id());
+        }
+
+        void request_redraw_if(bool changed, unsigned& stamp, int pnlId) {
+            if (redraws_) redraws_->request_if(changed, stamp, pnlId, get_id());
+        }
+
     private:
         int ctrlId_;
+        redraw_queue* redraws_{ nullptr };
     };
 }
\ No newline at end of file
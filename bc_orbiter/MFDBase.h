@@ -19,7 +19,10 @@
 #include "Component.h"
 #include "vessel.h"
 #include "Control.h"
+#include "Tools.h"
 #include <map>
+#include <string>
+#include <utility>
 
 namespace bc_orbiter
 {
@@ -45,6 +48,8 @@ namespace bc_orbiter
 				? 4.0 : 0.0; 
 		}
 
+		bool reports_draw() const override { return true; }
+
 		void on_change(double v) {
 			if (!IsPowered()) { oapiOpenMFD(MFD_NONE, mfdId_); }
 		}
@@ -64,6 +69,19 @@ namespace bc_orbiter
 		*/
 		const char* GetButtonLabel(int button);
 
+		/**
+		Draws the label of button area 'id' centered on 'x' at 'y', and remembers it so Redraw
+		only triggers buttons whose label has changed since.
+		*/
+		void DrawLabel(int id, int x, int y, SURFHANDLE surf, FontInfo& font);
+
+		/**
+		Call at the end of the VC and panel loads with the surface the labels are drawn on.  The
+		loaded surface shows none of the labels drawn on it before, so they are forgotten and redrawn.
+		The font comes from the loaded mesh too, so the rendered labels are dropped as well.
+		*/
+		void LoadLabelSurface(SURFHANDLE surf);
+
 		/**
 		Handles the mouse event.
 		*/
@@ -92,6 +110,9 @@ namespace bc_orbiter
 		
 		int						mfdId_{ 0 };
 		std::map<int, int>		mfdButtonIds_;
+		std::map<std::pair<SURFHANDLE, int>, std::string>	drawnLabels_;		// Last label drawn per surface and button area.
+		SURFHANDLE				labelSurface_{ nullptr };	// Surface the buttons are showing on.
+		text_renderer			labels_{ 512, 512, 64 };
 
 		int						idPower_{ 0 };
 		int						idSelect_{ 0 };
@@ -109,6 +130,7 @@ namespace bc_orbiter
 		if (mfdId == mfdId_)
 		{
 			Redraw();
+			power_.draw_changed(this);
 		}
 	}
 
@@ -125,6 +147,24 @@ namespace bc_orbiter
 		return label;
 	}
 
+	inline void MFDBase::DrawLabel(int id, int x, int y, SURFHANDLE surf, FontInfo& font)
+	{
+		// Erase three characters from 20 left of center, then the label centered.
+		auto label = GetButtonLabel(id);
+		if (label == nullptr) label = "";
+		labels_.set_font(font.surfSource, FixedFontFace(font));
+		labels_.draw(surf, x, y, label, text_align::center, { -20, 3 * font.charWidth });
+		drawnLabels_[{ surf, id }] = label;
+	}
+
+	inline void MFDBase::LoadLabelSurface(SURFHANDLE surf)
+	{
+		labelSurface_ = surf;
+		labels_.clear();
+		std::erase_if(drawnLabels_, [surf](const auto& d) { return d.first.first == surf; });
+		Redraw();
+	}
+
 	inline bool MFDBase::OnMouseEvent(int id, int event)
 	{
 		bool result = false;
@@ -171,14 +211,16 @@ namespace bc_orbiter
 
 	inline void MFDBase::Redraw()
 	{
+		// Power, select and menu are never redrawn, and buttons showing the right label are left alone.
 		for (auto &p : mfdButtonIds_)
 		{
-            vessel_.TriggerRedrawArea(0, 0, p.first);
+			auto label = GetButtonLabel(p.first);
+			auto drawn = drawnLabels_.find({ labelSurface_, p.first });
+			if ((drawn == drawnLabels_.end()) || (drawn->second != ((label == nullptr) ? "" : label)))
+			{
+				vessel_.TriggerRedrawArea(0, 0, p.first);
+			}
 		}
-
-        vessel_.TriggerRedrawArea(0, 0, idPower_);
-        vessel_.TriggerRedrawArea(0, 0, idSelect_);
-        vessel_.TriggerRedrawArea(0, 0, idMenu_);
 	}
 
 	inline void MFDBase::AssignKey(int areaId, int mfdKey)
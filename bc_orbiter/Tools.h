@@ -17,6 +17,9 @@
 #pragma once
 
 #include "Orbitersdk.h"
+#include "digits.h"
+#include "mesh_edit_batch.h"
+#include "text_renderer.h"
 
 namespace bc_orbiter
 {
@@ -34,21 +37,6 @@ namespace bc_orbiter
 		int blankY;					// Vertical start of blank.
 	};
 
-	/**
-	Contains the place values for a number.  Useful for things like altimeters.
-	*/
-	struct TensParts
-	{
-		double Hundredths;
-		double Tenths;
-		double Tens;
-		double Hundreds;
-		double Thousands;
-		double TenThousands;
-		double HundredThousands;
-		double Millions;
-	};
-
 	struct IntParts {
 		double Ones;
 		double Tens;
@@ -130,56 +118,6 @@ namespace bc_orbiter
 	//	out.Tens = (remainder / 1) / 10;
 	//}
 
-	/**
-	Breaks the number into its tenparts components.  Each
-	part will be a whole number plus a hundredths part.  This is useful
-	for 'barrel' numbers.
-	*/
-	inline void GetDigits(double number, TensParts& out)
-	{
-#pragma warning(push)
-#pragma warning(disable : 6031)
-		 // fmod(num, den) returns the remainder of num/den rounded to 0.
-		 // so 123, for example, is .3.
-
-		 // Start by multiplying by 100.  This moves hundreths into
-		 // the whole number range.  So, for example, the incoming number
-		 // is 234.56, that becomes 23456.
-		 double numberIn = number * 100;	// Move hundreths into the whole number.
-
-		 // Now get fmod.  In our example, this is '6'.  23456 / 10 = 2345.[6]
-	  //out.Hundredths = fmod(numberIn, 10.0);
-		 modf(fmod(numberIn, 10.0), &out.Hundredths);
-
-		 // Divide by 10 and keep going.
-		 numberIn /= 10;
-		 //out.Tenths = fmod(numberIn, 10.0);
-		 modf(fmod(numberIn, 10.0), &out.Tenths);
-
-		 numberIn /= 10;
-		 //out.Tens = fmod(numberIn, 10.0);
-		 modf(fmod(numberIn, 10.0), &out.Tens);
-
-		 numberIn /= 10;
-		 //out.Hundreds = fmod(numberIn, 10.0);
-		 modf(fmod(numberIn, 10.0), &out.Hundreds);
-
-		 numberIn /= 10;
-		 //out.Thousands = fmod(numberIn, 10.0);
-		 modf(fmod(numberIn, 10.0), &out.Thousands);
-
-		 numberIn /= 10;
-		 modf(fmod(numberIn, 10.0), &out.TenThousands);
-
-		 numberIn /= 10;
-		 modf(fmod(numberIn, 10.0), &out.HundredThousands);
-
-		 numberIn /= 10;
-		 modf(fmod(numberIn, 10.0), &out.Millions);
-
-#pragma warning(pop)
-	}
-
 	inline VECTOR3 RotateVector(const VECTOR3 &input, double angle, const VECTOR3 &rotationaxis)
 	{
 		// To rotate a vector in 3D space we'll need to build a matrix, these are the variables required to do so.
@@ -328,10 +266,9 @@ namespace bc_orbiter
 	}
 
 	/**
-	Calculates the KIAS for the given vessel.
-	@param vessel Vessel to get KIAS for.
+	Calculates KIAS from mach, static pressure and the atmosphere's ratio of specific heats.
 	*/
-	inline double GetVesselKias(const VESSEL3* vessel)
+	inline double CalcKias(double mach, double staticAtmoPres, double gamma)
 	{
 		auto result = 0.0;
 
@@ -339,33 +276,18 @@ namespace bc_orbiter
 		// speed of sound at sea level
 		double speedOfSound = 340.29;   // m/s
 
-		double ias = 0;
-		double dynPres, mach;
-		const ATMCONST *atmConst;
-		OBJHANDLE atmRef = vessel->GetAtmRef();		// Get ref for current body, null if none.
-		if (atmRef != NULL) {
-			double staticAtmoPres = vessel->GetAtmPressure();	// static atmospheric pressure.
-
-			// Retrieve the ratio of specific heats
-			atmConst = oapiGetPlanetAtmConstants(atmRef);
-			double gamma = atmConst->gamma;
-
-			// Mach number
-			mach = vessel->GetMachNumber();
-
-			// Determine the dynamic pressure using the
-			// thermal definition for stagnation pressure
-			dynPres = (gamma - 1) * pow(mach, 2.0) / 2 + 1;
-			dynPres = pow(dynPres, gamma / (gamma - 1));
-			// Convert stagnation pressure to dynamic pressure
-			dynPres = dynPres * staticAtmoPres - staticAtmoPres;
-
-			// Following is the equation from the Orbiter manual, page 62
-			ias = dynPres / ATMP + 1;
-			ias = pow(ias, ((gamma - 1) / gamma)) - 1.0;
-			ias = ias * 2 / (gamma - 1);
-			ias = sqrt(ias) * speedOfSound;
-		}
+		// Determine the dynamic pressure using the
+		// thermal definition for stagnation pressure
+		double dynPres = (gamma - 1) * pow(mach, 2.0) / 2 + 1;
+		dynPres = pow(dynPres, gamma / (gamma - 1));
+		// Convert stagnation pressure to dynamic pressure
+		dynPres = dynPres * staticAtmoPres - staticAtmoPres;
+
+		// Following is the equation from the Orbiter manual, page 62
+		double ias = dynPres / ATMP + 1;
+		ias = pow(ias, ((gamma - 1) / gamma)) - 1.0;
+		ias = ias * 2 / (gamma - 1);
+		ias = sqrt(ias) * speedOfSound;
 
 //		sprintf(oapiDebugString(), "IAS M/S: %+4.2f", ias);
 		result = ias * 1.94384; // To knots.
@@ -375,21 +297,43 @@ namespace bc_orbiter
 	}
 
 	/**
-	Calculate the KEAS for the given vessel.
+	Calculates the KIAS for the given vessel.
+	@param vessel Vessel to get KIAS for.
+	*/
+	inline double GetVesselKias(const VESSEL3* vessel)
+	{
+		OBJHANDLE atmRef = vessel->GetAtmRef();		// Get ref for current body, null if none.
+		if (atmRef == NULL) return 0.0;
+
+		// Retrieve the ratio of specific heats
+		auto atmConst = oapiGetPlanetAtmConstants(atmRef);
+		return CalcKias(vessel->GetMachNumber(), vessel->GetAtmPressure(), atmConst->gamma);
+	}
+
+	/**
+	Calculates KEAS from mach and static pressure.
 	Knots Equivalent Air Speed -- adjusted for atmospheric air pressure.
-	@param vessel Vessel to get KEAS for.
 	*/
-	inline double GetVesselKeas(const VESSEL3* vessel)
+	inline double CalcKeas(double mach, double staticAtmoPres)
 	{
 		const double speedOfSound = 340.29;		// Speed of sound in meters per second.
 		const double msKnots = 1.94384;			// Convert m/s to knots
 		
-		return	(	vessel->GetMachNumber() *				// Start with mach
+		return	(	mach *									// Start with mach
 					speedOfSound *							// Multiply by speed of sound
-					sqrt(vessel->GetAtmPressure() / ATMP)	// Multiply by atmo pressure ration squared.  As you get higher this goes to 0.
+					sqrt(staticAtmoPres / ATMP)				// Multiply by atmo pressure ration squared.  As you get higher this goes to 0.
 				) * msKnots;								// Convert to knots.
 	}
 
+	/**
+	Calculate the KEAS for the given vessel.
+	@param vessel Vessel to get KEAS for.
+	*/
+	inline double GetVesselKeas(const VESSEL3* vessel)
+	{
+		return CalcKeas(vessel->GetMachNumber(), vessel->GetAtmPressure());
+	}
+
 	/**
 	Calculate the G force on the vessel.
 	@param vessel Vessel to calculate G forces for.
@@ -504,6 +448,32 @@ namespace bc_orbiter
 		}
 	}
 
+	/**
+	Surface calls for basic_text_renderer.
+	*/
+	struct oapi_surfaces
+	{
+		using handle = SURFHANDLE;
+
+		static void blit(handle target, handle source, int tx, int ty, int sx, int sy, int w, int h)
+		{
+			oapiBlt(target, source, tx, ty, sx, sy, w, h);
+		}
+
+		static handle create(int w, int h) { return oapiCreateSurface(w, h); }
+		static void destroy(handle surf) { oapiDestroySurface(surf); }
+	};
+
+	using text_renderer = basic_text_renderer<oapi_surfaces>;
+
+	/**
+	Returns the font_face of a fixed width FontInfo font.
+	*/
+	inline font_face FixedFontFace(const FontInfo& font)
+	{
+		return font_face::fixed(font.sourceX, font.sourceY, font.charWidth, font.charHeight, font.blankX, font.blankY);
+	}
+
 	/**
 	Returns distance and direction from point one on a globe to point two given the longitude and
 	latitude of each point.
@@ -563,6 +533,10 @@ namespace bc_orbiter
 		return true;
 	}
 
+	/**
+	TranslateMesh, RotateMesh, TransformUV
+	Queue an edit of a four vertex group in mesh_edit_batch, vessel applies them at the end of the frame.
+	*/
 	template<typename T>
 	inline void TranslateMesh(T mesh, const UINT group, const NTVERTEX* verts, const VECTOR3& trans)
 	{
@@ -571,16 +545,8 @@ namespace bc_orbiter
 			return;
 		}
 
-		GROUPEDITSPEC change{};
-		NTVERTEX delta[4];
-
+		auto delta = mesh_edit_batch<T>::instance().edit(mesh, group, GRPEDIT_VTXCRD);
 		TransformXY2d(verts, delta, 4, trans, 0.0);
-
-		change.flags = GRPEDIT_VTXCRD;
-		change.nVtx = 4;
-		change.vIdx = NULL; //Just use the mesh order
-		change.Vtx = delta;
-		oapiEditMeshGroup(mesh, group, &change);
 	}
 
 	template<typename T>
@@ -591,16 +557,8 @@ namespace bc_orbiter
 			return;
 		}
 
-		GROUPEDITSPEC change {};
-		NTVERTEX delta[4];
-
+		auto delta = mesh_edit_batch<T>::instance().edit(mesh, group, GRPEDIT_VTXCRD);
 		TransformXY2d(verts, delta, 4, _V(0.0, 0.0, 0.0), angle);
-
-		change.flags = GRPEDIT_VTXCRD;
-		change.nVtx = 4;
-		change.vIdx = NULL; //Just use the mesh order
-		change.Vtx = delta;
-		oapiEditMeshGroup(mesh, group, &change);
 	}
 
 	template<typename T>
@@ -611,16 +569,8 @@ namespace bc_orbiter
 			return;
 		}
 
-		GROUPEDITSPEC change{};
-		NTVERTEX delta[4];
-
+		auto delta = mesh_edit_batch<T>::instance().edit(mesh, group, GRPEDIT_VTXTEX);
 		TransformUV2d(verts, delta, 4, trans, angle);
-
-		change.flags = GRPEDIT_VTXTEX;
-		change.nVtx = 4;
-		change.vIdx = NULL; //Just use the mesh order
-		change.Vtx = delta;
-		oapiEditMeshGroup(mesh, group, &change);
 	}
 
 	inline void DrawPanelOnOff(MESHHANDLE mesh, UINT group, const NTVERTEX* verts, bool isOn, double offset)
@@ -0,0 +1,292 @@
+//	aero_database - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// No Orbiter dependencies, so the loader can be built and checked outside Orbiter.
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bc_orbiter {
+
+	/**
+	aero_axis
+	Breakpoints of one grid axis, increasing, any spacing.
+	*/
+	class aero_axis
+	{
+	public:
+		aero_axis() = default;
+		explicit aero_axis(std::vector<double> points) : points_(std::move(points)) {}
+
+		size_t size() const { return points_.size(); }
+		double operator[](size_t i) const { return points_[i]; }
+		const std::vector<double>& points() const { return points_; }
+
+		/**
+		locate
+		Finds the cell holding 'x' (clamped to the axis) and the fraction across it.  'hint' is the
+		cell found last time; aoa and mach move little between calls so the search usually ends there.
+		*/
+		size_t locate(double x, size_t& hint, double& f) const
+		{
+			auto last = points_.size() - 2;
+			auto i = std::min(hint, last);
+
+			if (x < points_[i]) {
+				if (x <= points_[0]) { hint = 0; f = 0.0; return 0; }
+				while (x < points_[i]) i--;
+			}
+			else if (x >= points_[i + 1]) {
+				if (x >= points_[last + 1]) { hint = last; f = 1.0; return last; }
+				while (x >= points_[i + 1]) i++;
+			}
+
+			hint = i;
+			f = (x - points_[i]) / (points_[i + 1] - points_[i]);
+			return i;
+		}
+
+	private:
+		std::vector<double>	points_;
+	};
+
+	/**
+	aero_hint
+	Grid cells found by the last lookup.  Keep one per caller (per vessel and airfoil) so lookups
+	start where the last one ended and the grids stay read only, safe to share between threads.
+	*/
+	struct aero_hint {
+		size_t	aoa{ 0 };
+		size_t	mach{ 0 };
+	};
+
+	/**
+	aero_coeff
+	Lift, moment and drag coefficients.
+	*/
+	struct aero_coeff {
+		double	cl{ 0.0 };
+		double	cm{ 0.0 };
+		double	cd{ 0.0 };
+	};
+
+	/**
+	aero_grid
+	Coefficients of one airfoil on an aoa (radians) x mach grid, packed mach major so a lookup
+	reads two short runs of memory.  Evaluated with bilinear interpolation, values outside the
+	grid are held at the edge.
+	*/
+	class aero_grid
+	{
+	public:
+		aero_grid() = default;
+
+		/**
+		build
+		Fills the grid from 'func', aero_coeff(double aoa, double mach).
+		*/
+		template<typename F>
+		aero_grid(const std::string& name, const aero_axis& aoa, const aero_axis& mach, F func) :
+			  name_(name)
+			, aoa_(aoa)
+			, mach_(mach)
+		{
+			values_.resize(aoa_.size() * mach_.size());
+			for (size_t m = 0; m < mach_.size(); m++) {
+				for (size_t a = 0; a < aoa_.size(); a++) {
+					at(a, m) = func(aoa_[a], mach_[m]);
+				}
+			}
+		}
+
+		aero_grid(const std::string& name, const aero_axis& aoa, const aero_axis& mach, std::vector<aero_coeff> values) :
+			  name_(name)
+			, aoa_(aoa)
+			, mach_(mach)
+			, values_(std::move(values))
+		{
+		}
+
+		aero_coeff evaluate(double aoa, double mach, aero_hint& hint) const
+		{
+			double fa, fm;
+			auto a = aoa_.locate(aoa, hint.aoa, fa);
+			auto m = mach_.locate(mach, hint.mach, fm);
+
+			auto lo = blend(at(a, m), at(a + 1, m), fa);
+			auto hi = blend(at(a, m + 1), at(a + 1, m + 1), fa);
+			return blend(lo, hi, fm);
+		}
+
+		const std::string& name() const		{ return name_; }
+		const aero_axis& aoa() const		{ return aoa_; }
+		const aero_axis& mach() const		{ return mach_; }
+		const aero_coeff& at(size_t a, size_t m) const { return values_[m * aoa_.size() + a]; }
+
+	private:
+		aero_coeff& at(size_t a, size_t m) { return values_[m * aoa_.size() + a]; }
+
+		static aero_coeff blend(const aero_coeff& a, const aero_coeff& b, double f)
+		{
+			return {
+				a.cl + (b.cl - a.cl) * f,
+				a.cm + (b.cm - a.cm) * f,
+				a.cd + (b.cd - a.cd) * f
+			};
+		}
+
+		std::string				name_;
+		aero_axis				aoa_;
+		aero_axis				mach_;
+		std::vector<aero_coeff>	values_;
+	};
+
+	/**
+	aero_database
+	Named aero_grids read from a text file, one row per grid point:
+
+		# comment
+		airfoil, mach, aoa(deg), cl, cm, cd
+
+	Rows of one airfoil must cover a full aoa x mach grid, in any order.  Blank lines and lines
+	starting with '#' are skipped.
+	*/
+	class aero_database
+	{
+	public:
+		/**
+		load
+		Replaces the contents with the grids in 'in'.  Returns false, with a reason in 'error',
+		if the file is malformed, in which case the database is left empty.
+		*/
+		bool load(std::istream& in, std::string& error)
+		{
+			grids_.clear();
+
+			struct row { double mach, aoa; aero_coeff c; };
+			std::vector<std::pair<std::string, std::vector<row>>> airfoils;
+
+			std::string line;
+			int lineNo = 0;
+			while (std::getline(in, line)) {
+				lineNo++;
+				auto first = line.find_first_not_of(" \t\r");
+				if ((first == std::string::npos) || (line[first] == '#')) continue;
+
+				std::replace(line.begin(), line.end(), ',', ' ');
+				std::istringstream fields(line);
+				std::string name;
+				row r;
+				double aoaDeg;
+				if (!(fields >> name >> r.mach >> aoaDeg >> r.c.cl >> r.c.cm >> r.c.cd)) {
+					error = "line " + std::to_string(lineNo) + ": expected airfoil, mach, aoa, cl, cm, cd";
+					return false;
+				}
+				r.aoa = aoaDeg * DEG_TO_RAD;
+
+				auto it = std::find_if(airfoils.begin(), airfoils.end(), [&](auto& a) { return a.first == name; });
+				if (it == airfoils.end()) {
+					airfoils.emplace_back(name, std::vector<row>());
+					it = airfoils.end() - 1;
+				}
+				it->second.push_back(r);
+			}
+
+			for (auto& [name, rows] : airfoils) {
+				std::vector<double> aoa, mach;
+				for (auto& r : rows) {
+					aoa.push_back(r.aoa);
+					mach.push_back(r.mach);
+				}
+				unique_sorted(aoa);
+				unique_sorted(mach);
+
+				if ((aoa.size() < 2) || (mach.size() < 2) || (rows.size() != aoa.size() * mach.size())) {
+					error = name + ": rows do not form a full aoa x mach grid (at least 2 x 2)";
+					grids_.clear();
+					return false;
+				}
+
+				std::vector<aero_coeff> values(rows.size());
+				std::vector<bool> seen(rows.size(), false);
+				for (auto& r : rows) {
+					auto a = std::lower_bound(aoa.begin(), aoa.end(), r.aoa) - aoa.begin();
+					auto m = std::lower_bound(mach.begin(), mach.end(), r.mach) - mach.begin();
+					auto i = m * aoa.size() + a;
+					if (seen[i]) {
+						error = name + ": duplicate row for one grid point";
+						grids_.clear();
+						return false;
+					}
+					seen[i] = true;
+					values[i] = r.c;
+				}
+
+				grids_.emplace_back(name, aero_axis(aoa), aero_axis(mach), std::move(values));
+			}
+
+			if (grids_.empty()) {
+				error = "no rows";
+				return false;
+			}
+
+			return true;
+		}
+
+		void save(std::ostream& out) const
+		{
+			out << "# airfoil, mach, aoa(deg), cl, cm, cd\n";
+			out.precision(6);
+			for (auto& g : grids_) {
+				for (size_t m = 0; m < g.mach().size(); m++) {
+					for (size_t a = 0; a < g.aoa().size(); a++) {
+						auto& c = g.at(a, m);
+						out << g.name() << ", " << g.mach()[m] << ", " << g.aoa()[a] / DEG_TO_RAD << ", "
+							<< c.cl << ", " << c.cm << ", " << c.cd << "\n";
+					}
+				}
+			}
+		}
+
+		void add(aero_grid grid) { grids_.push_back(std::move(grid)); }
+
+		const aero_grid* find(const std::string& name) const
+		{
+			auto it = std::find_if(grids_.begin(), grids_.end(), [&](auto& g) { return g.name() == name; });
+			return (it == grids_.end()) ? nullptr : &*it;
+		}
+
+		size_t size() const { return grids_.size(); }
+
+	private:
+		static constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+		static void unique_sorted(std::vector<double>& v)
+		{
+			std::sort(v.begin(), v.end());
+			v.erase(std::unique(v.begin(), v.end()), v.end());
+		}
+
+		std::vector<aero_grid>	grids_;
+	};
+}
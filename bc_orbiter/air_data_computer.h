@@ -0,0 +1,145 @@
+//	air_data_computer - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Orbitersdk.h"
+#include "handler_interfaces.h"
+#include "signals.h"
+#include "vessel.h"
+
+#include <cmath>
+
+namespace bc_orbiter {
+
+	/**
+	air_data_computer
+	Works out the air data the speed gauges show once per frame from the vessel flight_state and
+	publishes it on signals.  It reads only mach, static pressure and density from the snapshot,
+	shared with the other avionics, and GetAtmRef.  The gamma dependent KIAS exponents are only
+	recomputed when the vessel changes atmosphere.
+
+	Register it with AddComponent before the components that read it so its values are current
+	in their post step.
+
+	@param maxDynPressure Dynamic pressure limit (Pa) used to find the max mach.
+	@param gaugeMaxMach Top of the log scale used for the gauge ratios.
+	@param isActive If given, air data is only worked out while it returns true, the signals keep
+	their last values otherwise.  Keeps the flight_state from being read when no gauge is powered.
+	*/
+	class air_data_computer :
+		  public vessel_component
+		, public post_step
+	{
+	public:
+		air_data_computer(double maxDynPressure, double gaugeMaxMach, delegate<bool()> isActive = nullptr) :
+			  maxDynPressure_(maxDynPressure)
+			, gaugeMaxMach_(gaugeMaxMach)
+			, logGaugeMax_(log(gaugeMaxMach + 1.0))
+			, isActive_(isActive)
+		{
+		}
+
+		// post_step
+		void handle_post_step(vessel& vessel, double simt, double simdt, double mjd) override {
+			if (isActive_ && !isActive_()) return;
+
+			auto& fs = vessel.GetFlightState();
+			auto mach = fs.mach();
+			auto atmPressure = fs.atm_pressure();
+			auto atmDensity = fs.atm_density();
+
+			auto kias = 0.0;
+			auto atmRef = vessel.GetAtmRef();
+			if (atmRef != NULL) {
+				if (atmRef != atmRef_) set_atmosphere(atmRef);
+				kias = calc_kias(mach, atmPressure);
+			}
+
+			auto maxMach = 0.0;
+			if (atmDensity > 0.0) {
+				maxMach = sqrt(maxDynPressure_ / atmDensity) / 331.34;
+			}
+
+			kiasSignal_.fire(kias);
+			keasSignal_.fire(CalcKeas(mach, atmPressure));
+			machSignal_.fire(mach);
+			maxMachSignal_.fire(maxMach);
+			machRatioSignal_.fire(gauge_ratio(mach));
+			maxMachRatioSignal_.fire(gauge_ratio(maxMach));
+		}
+
+		/**
+		gauge_ratio
+		Position, 0 to 1, of 'mach' on the log scale of the speed gauges.  Values are pinned to 0 and gaugeMaxMach.
+		*/
+		double gauge_ratio(double mach) const {
+			if (mach <= 0.0) return 0.0;
+			if (mach > gaugeMaxMach_) mach = gaugeMaxMach_;
+			return log(mach + 1.0) / logGaugeMax_;
+		}
+
+		signal<double>& KiasSignal()			{ return kiasSignal_; }
+		signal<double>& KeasSignal()			{ return keasSignal_; }
+		signal<double>& MachSignal()			{ return machSignal_; }
+		signal<double>& MaxMachSignal()			{ return maxMachSignal_; }		// Not pinned.
+		signal<double>& MachRatioSignal()		{ return machRatioSignal_; }
+		signal<double>& MaxMachRatioSignal()	{ return maxMachRatioSignal_; }
+
+	private:
+		void set_atmosphere(OBJHANDLE atmRef) {
+			atmRef_ = atmRef;
+			auto gamma = oapiGetPlanetAtmConstants(atmRef)->gamma;
+			stagExp_ = gamma / (gamma - 1);
+			stagCubeRoot_ = (fabs(stagExp_ - 3.5) < 1e-9);
+			iasExp_ = (gamma - 1) / gamma;
+			halfGm1_ = (gamma - 1) / 2;
+			twoOverGm1_ = 2 / (gamma - 1);
+		}
+
+		// Same steps as CalcKias in Tools.h with the exponents cached.  A gamma of 1.4, Earth, makes
+		// the stagnation exponent 3.5, worked out as x^3 sqrt(x) instead of pow.
+		double calc_kias(double mach, double staticAtmoPres) const {
+			const double speedOfSound = 340.29;		// m/s at sea level
+			const double msKnots = 1.94384;
+
+			auto stag = halfGm1_ * mach * mach + 1;
+			stag = stagCubeRoot_ ? stag * stag * stag * sqrt(stag) : pow(stag, stagExp_);
+			auto dynPres = stag * staticAtmoPres - staticAtmoPres;
+			auto ias = (pow(dynPres / ATMP + 1, iasExp_) - 1.0) * twoOverGm1_;
+			return sqrt(ias) * speedOfSound * msKnots;
+		}
+
+		double		maxDynPressure_;
+		double		gaugeMaxMach_;
+		double		logGaugeMax_;
+		delegate<bool()>	isActive_;
+
+		OBJHANDLE	atmRef_{ nullptr };
+		double		stagExp_{ 0.0 };
+		bool		stagCubeRoot_{ false };
+		double		iasExp_{ 0.0 };
+		double		halfGm1_{ 0.0 };
+		double		twoOverGm1_{ 0.0 };
+
+		signal<double>	kiasSignal_;
+		signal<double>	keasSignal_;
+		signal<double>	machSignal_;
+		signal<double>	maxMachSignal_;
+		signal<double>	machRatioSignal_;
+		signal<double>	maxMachRatioSignal_;
+	};
+}
@@ -0,0 +1,246 @@
+//	animation_store - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Animation.h"
+
+#include <limits>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BCO_ANIMATION_SSE2
+#endif
+
+namespace bc_orbiter {
+
+	/**
+	animation_kernel
+	Steps a contiguous block of animation states towards their targets.  Each specialization
+	matches the scalar update_state of its policy in Animation.h, two lanes at a time where SSE2
+	is available.
+	*/
+	template<typename T>
+	struct animation_kernel;
+
+	template<>
+	struct animation_kernel<state_update_direct>
+	{
+		static void step(double* state, const double* target, const double* /*speed*/, size_t n, double /*dt*/)
+		{
+			for (size_t i = 0; i < n; i++) state[i] = target[i];
+		}
+	};
+
+	template<>
+	struct animation_kernel<state_update_target>
+	{
+		static void step(double* state, const double* target, const double* speed, size_t n, double dt)
+		{
+			size_t i = 0;
+#ifdef BCO_ANIMATION_SSE2
+			const auto vdt = _mm_set1_pd(dt);
+			const auto absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+
+			for (; i + 2 <= n; i += 2) {
+				auto s = _mm_loadu_pd(state + i);
+				auto t = _mm_loadu_pd(target + i);
+				auto da = _mm_mul_pd(vdt, _mm_loadu_pd(speed + i));
+				auto diff = _mm_sub_pd(t, s);
+
+				// Move da towards the target without passing it, or snap to it when da covers the distance.
+				auto up = _mm_cmpgt_pd(diff, _mm_setzero_pd());
+				auto moved = _mm_or_pd(
+					_mm_and_pd(up, _mm_min_pd(t, _mm_add_pd(s, da))),
+					_mm_andnot_pd(up, _mm_max_pd(t, _mm_sub_pd(s, da))));
+				auto snap = _mm_cmpgt_pd(da, _mm_and_pd(diff, absMask));
+				auto r = _mm_or_pd(_mm_and_pd(snap, t), _mm_andnot_pd(snap, moved));
+
+				auto same = _mm_cmpeq_pd(s, t);
+				r = _mm_or_pd(_mm_and_pd(same, s), _mm_andnot_pd(same, r));
+
+				auto isNan = _mm_cmpunord_pd(r, r);
+				_mm_storeu_pd(state + i, _mm_andnot_pd(isNan, r));
+			}
+#endif
+			for (; i < n; i++) {
+				state_update su{ speed[i], state[i], target[i] };
+				state_update_target::update_state(su, dt);
+				state[i] = su.state_;
+			}
+		}
+	};
+
+	template<>
+	struct animation_kernel<state_update_wrap>
+	{
+		static void step(double* state, const double* target, const double* speed, size_t n, double dt)
+		{
+			size_t i = 0;
+#ifdef BCO_ANIMATION_SSE2
+			const auto vdt = _mm_set1_pd(dt);
+			const auto zero = _mm_setzero_pd();
+			const auto one = _mm_set1_pd(1.0);
+			const auto half = _mm_set1_pd(0.5);
+			const auto nhalf = _mm_set1_pd(-0.5);
+
+			auto select = [](__m128d mask, __m128d a, __m128d b) {
+				return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+			};
+
+			for (; i + 2 <= n; i += 2) {
+				auto s = _mm_loadu_pd(state + i);
+				auto da = _mm_mul_pd(vdt, _mm_loadu_pd(speed + i));
+				auto nda = _mm_sub_pd(zero, da);
+				auto df = _mm_sub_pd(_mm_loadu_pd(target + i), s);
+
+				// See state_update_wrap for the four cases.
+				auto neg = select(_mm_cmplt_pd(df, nhalf), _mm_min_pd(da, _mm_add_pd(df, one)), _mm_max_pd(nda, df));
+				auto pos = select(_mm_cmpgt_pd(df, half), _mm_max_pd(nda, _mm_sub_pd(df, one)), _mm_min_pd(df, da));
+				auto move = select(_mm_cmplt_pd(df, zero), neg, pos);
+
+				auto r = _mm_add_pd(s, move);
+				r = _mm_sub_pd(r, _mm_and_pd(_mm_cmpgt_pd(r, one), one));
+				r = _mm_add_pd(r, _mm_and_pd(_mm_cmplt_pd(r, zero), one));
+
+				_mm_storeu_pd(state + i, select(_mm_cmpeq_pd(df, zero), s, r));
+			}
+#endif
+			for (; i < n; i++) {
+				state_update su{ speed[i], state[i], target[i] };
+				state_update_wrap::update_state(su, dt);
+				state[i] = su.state_;
+			}
+		}
+	};
+
+	/**
+	animation_store
+	Keeps speed, state and target for every animation of one update policy in parallel arrays
+	so they can be stepped as a block.  There is one store per policy, shared by every vessel
+	in the module; step is keyed on sim time so it only runs once per frame no matter how many
+	vessels call it.  Use animation_handle rather than the store directly.
+	*/
+	template<typename T>
+	class animation_store
+	{
+	public:
+		static animation_store& instance()
+		{
+			static animation_store store;
+			return store;
+		}
+
+		size_t add(double speed)
+		{
+			size_t slot;
+			if (!free_.empty()) {
+				slot = free_.back();
+				free_.pop_back();
+			}
+			else {
+				slot = speed_.size();
+				speed_.push_back(0.0);
+				state_.push_back(0.0);
+				target_.push_back(0.0);
+			}
+
+			speed_[slot] = speed;
+			state_[slot] = 0.0;
+			target_[slot] = 0.0;
+			return slot;
+		}
+
+		void remove(size_t slot)
+		{
+			speed_[slot] = 0.0;
+			target_[slot] = state_[slot];
+			free_.push_back(slot);
+		}
+
+		void step(double simt, double dt)
+		{
+			if (simt == lastStep_) return;
+			lastStep_ = simt;
+			animation_kernel<T>::step(state_.data(), target_.data(), speed_.data(), state_.size(), dt);
+		}
+
+		double	state(size_t slot) const				{ return state_[slot]; }
+		double	target(size_t slot) const				{ return target_[slot]; }
+		void	set_target(size_t slot, double target)	{ target_[slot] = target; }
+		void	set_state(size_t slot, double state)	{ state_[slot] = state; target_[slot] = state; }
+
+	private:
+		animation_store() = default;
+
+		std::vector<double>	speed_;
+		std::vector<double>	state_;
+		std::vector<double>	target_;
+		std::vector<size_t>	free_;
+		double				lastStep_{ -std::numeric_limits<double>::infinity() };
+	};
+
+	/**
+	step_animation_stores
+	Called once per frame by vessel before any control reads its animation state.
+	*/
+	inline void step_animation_stores(double simt, double dt)
+	{
+		animation_store<state_update_target>::instance().step(simt, dt);
+		animation_store<state_update_wrap>::instance().step(simt, dt);
+		animation_store<state_update_direct>::instance().step(simt, dt);
+	}
+
+	/**
+	animation_handle
+	Owns one slot in the animation_store for policy T.  Controls hold one of these in place of
+	an animation_base, set the target and read back the state the store stepped.
+	*/
+	template<typename T>
+	class animation_handle
+	{
+	public:
+		animation_handle(double speed) : slot_(store().add(speed)) {}
+		~animation_handle() { if (valid_) store().remove(slot_); }
+
+		animation_handle(const animation_handle&) = delete;
+		animation_handle& operator=(const animation_handle&) = delete;
+
+		animation_handle(animation_handle&& other) noexcept : slot_(other.slot_), valid_(other.valid_) { other.valid_ = false; }
+
+		double	GetState() const			{ return store().state(slot_); }
+		void	SetTarget(double target)	{ store().set_target(slot_, target); }
+		void	SetState(double state)		{ store().set_state(slot_, state); }
+
+	private:
+		static animation_store<T>& store() { return animation_store<T>::instance(); }
+
+		size_t	slot_;
+		bool	valid_{ true };
+	};
+
+	/**
+	animation_policy
+	Maps an animation_base type (animation_target, animation_wrap) to its update policy so
+	controls templated on the animation type can use the matching store.
+	*/
+	template<typename A>
+	struct animation_policy;
+
+	template<typename T>
+	struct animation_policy<animation_base<T>> { using type = T; };
+}
@@ -0,0 +1,132 @@
+//	consumable_flow - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cmath>
+
+namespace bc_orbiter {
+
+	/**
+	flow_rates
+	Rates applied to a tank over one step.  fill and draw are in units per second, boilOff is
+	the fraction of the current contents lost per second.
+	*/
+	struct flow_rates {
+		double	fill{ 0.0 };
+		double	draw{ 0.0 };
+		double	boilOff{ 0.0 };
+	};
+
+	/**
+	flow_result
+	Tank contents after the step, the amounts moved, and when during the step the tank became full or
+	empty (seconds from the start, negative if it did not).
+	*/
+	struct flow_result {
+		double	level{ 0.0 };
+		double	filled{ 0.0 };
+		double	drawn{ 0.0 };
+		double	boiled{ 0.0 };
+		double	fullAt{ -1.0 };
+		double	emptyAt{ -1.0 };
+	};
+
+	/**
+	integrate_flow
+	Integrates level' = fill - draw - boilOff * level over 'dt' in closed form, so the result does not
+	depend on how the time is split into steps.  The step is cut at the exact moment the tank fills or
+	empties: filling stops when full, and once empty the draw is limited to what is still flowing in.
+
+	@param level Contents at the start of the step, 0 to capacity.
+	*/
+	inline flow_result integrate_flow(double level, double capacity, const flow_rates& rates, double dt)
+	{
+		flow_result result;
+		auto fill = rates.fill;
+		auto draw = rates.draw;
+		const auto k = rates.boilOff;
+		double t = 0.0;
+
+		// At most four pieces: stop the pump, run to full or empty, run to the other, then the rest.
+		for (int piece = 0; (piece < 4) && (t < dt); piece++) {
+			auto remain = dt - t;
+			auto net = fill - draw;
+
+			// Empty with more going out than in: the level stays at zero and the draw takes what comes in.
+			if ((level <= 0.0) && (net <= 0.0)) {
+				if (result.emptyAt < 0.0) result.emptyAt = t;
+				result.filled += fill * remain;
+				result.drawn += fill * remain;
+				level = 0.0;
+				break;
+			}
+
+			// Full with the pump running: the pump stops.
+			if ((level >= capacity) && (fill > 0.0)) {
+				if (result.fullAt < 0.0) result.fullAt = t;
+				fill = 0.0;
+				continue;
+			}
+
+			// level(s) = settle + (level - settle) * e^(-k s), or level + net * s without boil off.
+			auto settle = (k > 0.0) ? net / k : 0.0;
+			auto level_at = [&](double s) {
+				return (k > 0.0) ? settle + (level - settle) * exp(-k * s) : level + net * s;
+			};
+
+			// Time to reach 'target', negative if the level never gets there.
+			auto time_to = [&](double target) {
+				if (k > 0.0) {
+					auto num = level - settle;
+					auto den = target - settle;
+					if ((num == 0.0) || (den == 0.0) || ((num > 0.0) != (den > 0.0)) || (fabs(den) >= fabs(num))) return -1.0;
+					return log(num / den) / k;
+				}
+				if (net == 0.0) return -1.0;
+				auto tt = (target - level) / net;
+				return (tt > 0.0) ? tt : -1.0;
+			};
+
+			auto rate = net - k * level;
+			auto target = (rate > 0.0) ? capacity : 0.0;
+			auto hit = (rate == 0.0) ? -1.0 : time_to(target);
+			auto isEvent = (hit >= 0.0) && (hit < remain);
+
+			auto span = isEvent ? hit : remain;
+			auto next = isEvent ? target : fmax(0.0, fmin(capacity, level_at(span)));
+
+			result.filled += fill * span;
+			result.drawn += draw * span;
+			result.boiled += (fill - draw) * span - (next - level);
+			level = next;
+			t += span;
+
+			if (isEvent) {
+				if (target == capacity) {
+					if (result.fullAt < 0.0) result.fullAt = t;
+					fill = 0.0;
+				}
+				else if (result.emptyAt < 0.0) {
+					result.emptyAt = t;
+				}
+			}
+		}
+
+		result.level = level;
+		return result;
+	}
+}
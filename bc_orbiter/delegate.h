@@ -0,0 +1,66 @@
+//	delegate - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace bc_orbiter {
+
+	/**
+	delegate
+	A callable wrapper used in place of std::function for signals, slots and animation callbacks.
+	The callable is stored inline and never allocates.  Captures must fit in Size bytes and be
+	trivially copyable, which holds for the usual [&] or [this] lambdas; both are checked at
+	compile time.  The delegate itself is trivially copyable.
+	*/
+	template<typename Signature, size_t Size = 4 * sizeof(void*)>
+	class delegate;
+
+	template<typename R, typename... Args, size_t Size>
+	class delegate<R(Args...), Size>
+	{
+	public:
+		delegate() = default;
+		delegate(std::nullptr_t) {}
+
+		template<typename F>
+			requires (!std::is_same_v<std::decay_t<F>, delegate>) && std::is_invocable_r_v<R, F&, Args...>
+		delegate(F func)
+		{
+			static_assert(sizeof(F) <= Size, "delegate: capture is too large, capture by reference or a pointer instead.");
+			static_assert(alignof(F) <= alignof(std::max_align_t), "delegate: capture alignment not supported.");
+			static_assert(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>,
+				"delegate: captures must be trivially copyable, capture by reference or a pointer instead.");
+
+			new (storage_) F(func);
+			invoke_ = [](const void* storage, Args... args) -> R {
+				return (*std::launder(static_cast<F*>(const_cast<void*>(storage))))(std::forward<Args>(args)...);
+			};
+		}
+
+		R operator()(Args... args) const { return invoke_(storage_, std::forward<Args>(args)...); }
+
+		explicit operator bool() const { return nullptr != invoke_; }
+
+	private:
+		alignas(std::max_align_t) unsigned char storage_[Size]{};
+		R(*invoke_)(const void*, Args...) { nullptr };
+	};
+}
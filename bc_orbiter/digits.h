@@ -0,0 +1,142 @@
+//	digits - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Place values for drum (barrel) displays.  No Orbiter headers, so Tools\DigitsCheck can build it.
+
+#include <cmath>
+#include <cstddef>
+
+#include <emmintrin.h>
+
+namespace bc_orbiter
+{
+	/**
+	Contains the place values for a number.  Useful for things like altimeters.
+	*/
+	struct TensParts
+	{
+		double Hundredths;
+		double Tenths;
+		double Tens;
+		double Hundreds;
+		double Thousands;
+		double TenThousands;
+		double HundredThousands;
+		double Millions;
+	};
+
+	/**
+	GetDigitsLarge
+	Place values by repeated fmod, for numbers past the range of the batch GetDigits.
+	*/
+	inline void GetDigitsLarge(double number, TensParts& out)
+	{
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 6031)		// modf's return, the fraction, is not wanted.
+#endif
+		 // fmod(num, den) returns the remainder of num/den rounded to 0.
+		 // so 123, for example, is .3.
+
+		 // Start by multiplying by 100.  This moves hundreths into
+		 // the whole number range.  So, for example, the incoming number
+		 // is 234.56, that becomes 23456.
+		 double numberIn = number * 100;	// Move hundreths into the whole number.
+
+		 // Now get fmod.  In our example, this is '6'.  23456 / 10 = 2345.[6]
+	  //out.Hundredths = fmod(numberIn, 10.0);
+		 modf(fmod(numberIn, 10.0), &out.Hundredths);
+
+		 // Divide by 10 and keep going.
+		 numberIn /= 10;
+		 //out.Tenths = fmod(numberIn, 10.0);
+		 modf(fmod(numberIn, 10.0), &out.Tenths);
+
+		 numberIn /= 10;
+		 //out.Tens = fmod(numberIn, 10.0);
+		 modf(fmod(numberIn, 10.0), &out.Tens);
+
+		 numberIn /= 10;
+		 //out.Hundreds = fmod(numberIn, 10.0);
+		 modf(fmod(numberIn, 10.0), &out.Hundreds);
+
+		 numberIn /= 10;
+		 //out.Thousands = fmod(numberIn, 10.0);
+		 modf(fmod(numberIn, 10.0), &out.Thousands);
+
+		 numberIn /= 10;
+		 modf(fmod(numberIn, 10.0), &out.TenThousands);
+
+		 numberIn /= 10;
+		 modf(fmod(numberIn, 10.0), &out.HundredThousands);
+
+		 numberIn /= 10;
+		 modf(fmod(numberIn, 10.0), &out.Millions);
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+	}
+
+	/**
+	Breaks each number into its tenparts components, two numbers at a time.  Each part is the
+	whole digit of that place (negative for negative numbers), the same as the fmod form.  Works
+	on the whole number of hundredths, so each place is an exact integer divide.  Pass all the
+	values of one instrument in one call.
+	*/
+	inline void GetDigits(const double* numbers, TensParts* out, size_t count)
+	{
+		const auto hundred = _mm_set1_pd(100.0);
+		const auto ten = _mm_set1_pd(10.0);
+		const auto limit = _mm_set1_pd(2147483647.0);		// Hundredths must fit the 32 bit convert.
+		const auto absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+
+		for (size_t i = 0; i < count; i += 2) {
+			auto lanes = (count - i < 2) ? 1 : 2;
+			auto x = _mm_mul_pd((lanes == 2) ? _mm_loadu_pd(numbers + i) : _mm_load1_pd(numbers + i), hundred);
+
+			if (_mm_movemask_pd(_mm_cmplt_pd(_mm_and_pd(x, absMask), limit)) != 3) {
+				for (auto k = 0; k < lanes; k++) GetDigitsLarge(numbers[i + k], out[i + k]);
+				continue;
+			}
+
+			// n / 10 is never rounded across a whole number, so each place is n - 10 * trunc(n / 10).
+			double d[8][2];
+			auto n = _mm_cvtepi32_pd(_mm_cvttpd_epi32(x));
+			for (auto& place : d) {
+				auto q = _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_div_pd(n, ten)));
+				_mm_storeu_pd(place, _mm_sub_pd(n, _mm_mul_pd(q, ten)));
+				n = q;
+			}
+
+			for (auto k = 0; k < lanes; k++) {
+				out[i + k] = { d[0][k], d[1][k], d[2][k], d[3][k], d[4][k], d[5][k], d[6][k], d[7][k] };
+			}
+		}
+	}
+
+	/**
+	Breaks the number into its tenparts components.  Each
+	part will be a whole number plus a hundredths part.  This is useful
+	for 'barrel' numbers.
+	*/
+	inline void GetDigits(double number, TensParts& out)
+	{
+		GetDigits(&number, &out, 1);
+	}
+}
@@ -0,0 +1,453 @@
+//	electrical_network - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Control.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bc_orbiter {
+
+	class electrical_network;
+
+	/**
+	electrical_bus
+	One bus in an electrical_network.  Consumers attach to a bus as their power_provider and see the
+	volts the network solved for it.
+
+	Load is tracked per bus.  Consumers that reports_draw are only re-read after draw_changed or a
+	volts change, the rest are polled each step.
+	*/
+	class electrical_bus : public power_provider
+	{
+	public:
+		electrical_bus(electrical_network& network, const std::string& name, size_t index, double breakerAmps) :
+			network_(network), name_(name), index_(index), breakerAmps_(breakerAmps)
+		{}
+
+		// power_provider
+		void attach_consumer(power_consumer* consumer) override {
+			consumers_.push_back(consumer);
+
+			if (consumer->reports_draw()) {
+				reportedIndex_[consumer] = reportedLoads_.size();
+				reportedLoads_.push_back({ consumer });
+				dirtyLoads_.push_back(reportedLoads_.size() - 1);   // amp_draw is read on the first step, the consumer may not be constructed yet.
+			}
+			else {
+				polledConsumers_.push_back(consumer);
+			}
+		}
+
+		void draw_changed(power_consumer* consumer) override {
+			auto it = reportedIndex_.find(consumer);
+			if (it != reportedIndex_.end()) mark_dirty(it->second);
+		}
+
+		double volts_available() const override { return volts_; }
+		double amp_load() const override { return load_; }
+
+		const std::string& name() const { return name_; }
+
+		/**
+		Breaker state.  A tripped bus is dead and isolated from its ties until reset_breaker.
+		*/
+		bool is_tripped() const { return isTripped_; }
+		void reset_breaker();
+
+		/**
+		Reporting consumers whose draw changed during the last step.
+		*/
+		const std::vector<power_consumer*>& changed_consumers() const { return changedConsumers_; }
+
+	private:
+		friend class electrical_network;
+
+		struct reported_load {
+			power_consumer*	consumer;
+			double			draw{ 0.0 };
+			bool			dirty{ true };
+		};
+
+		void mark_dirty(size_t i) {
+			if (reportedLoads_[i].dirty) return;
+			reportedLoads_[i].dirty = true;
+			dirtyLoads_.push_back(i);
+		}
+
+		double update_load() {
+			changedConsumers_.clear();
+			for (auto i : dirtyLoads_) {
+				auto& l = reportedLoads_[i];
+				l.dirty = false;
+
+				auto draw = l.consumer->amp_draw();
+				if (draw != l.draw) {
+					reportedDraw_ += draw - l.draw;
+					l.draw = draw;
+					changedConsumers_.push_back(l.consumer);
+				}
+			}
+			dirtyLoads_.clear();
+
+			load_ = reportedDraw_;
+			for (auto c : polledConsumers_) load_ += c->amp_draw();
+			return load_;
+		}
+
+		void set_volts(double v) {
+			if (isSolved_ && (v == volts_)) return;		// Always notify on the first solve.
+			isSolved_ = true;
+			volts_ = v;
+
+			for (auto c : consumers_) c->on_change(volts_);
+
+			// Most draws depend on the volts, re-read every reporting consumer next step.
+			for (size_t i = 0; i < reportedLoads_.size(); i++) mark_dirty(i);
+		}
+
+		electrical_network&		network_;
+		std::string				name_;
+		size_t					index_;
+		double					breakerAmps_;
+		bool					isTripped_{ false };
+		bool					isSolved_{ false };
+
+		double					volts_{ 0.0 };
+		double					load_{ 0.0 };
+		size_t					supply_{ SIZE_MAX };		// Source feeding this bus at the last solve.
+
+		std::vector<size_t>		ties_;
+		std::vector<size_t>		sources_;
+
+		std::vector<power_consumer*>	consumers_;
+		std::vector<power_consumer*>	polledConsumers_;
+		std::vector<power_consumer*>	changedConsumers_;
+		std::vector<reported_load>		reportedLoads_;
+		std::vector<size_t>				dirtyLoads_;
+		std::unordered_map<const power_consumer*, size_t> reportedIndex_;
+		double							reportedDraw_{ 0.0 };
+	};
+
+	/**
+	electrical_network
+	Buses joined by tie switches and fed by sources.  A bus, and every bus reachable from it through
+	closed ties, forms a connected group that shares the volts of its best source: the highest primary
+	source, or the highest backup source (battery) when no primary reaches useableVolts.
+
+	Switch events (ties, source connect, source volts, breakers) only mark the buses they touch.  step
+	re-solves just the groups containing those buses, so a frame with no switch events costs the load
+	update and nothing else.
+
+	Batteries are backup sources whose volts follow a discharge curve over their charge level.  They
+	discharge by the load they supply and charge from a primary source on their bus.
+	*/
+	class electrical_network
+	{
+	public:
+		electrical_network(double useableVolts) : useableVolts_(useableVolts) {}
+
+		/**
+		add_bus
+		@param breakerAmps Load that trips the bus breaker, 0 for no breaker.
+		*/
+		electrical_bus& add_bus(const std::string& name, double breakerAmps = 0.0) {
+			buses_.push_back(std::make_unique<electrical_bus>(*this, name, buses_.size(), breakerAmps));
+			mark(buses_.back()->index_);
+			return *buses_.back();
+		}
+
+		electrical_bus* find_bus(const std::string& name) {
+			for (auto& b : buses_) {
+				if (b->name_ == name) return b.get();
+			}
+			return nullptr;
+		}
+
+		/**
+		add_source
+		@return Source id used with the set_source_ calls.
+		*/
+		size_t add_source(electrical_bus& bus, bool isBackup = false) {
+			sources_.push_back({ bus.index_, isBackup });
+			bus.sources_.push_back(sources_.size() - 1);
+			return sources_.size() - 1;
+		}
+
+		/**
+		add_battery
+		A backup source on 'bus' with a capacity in amp hours.  Its volts come from the discharge curve.
+		@param fullVolts Volts at full charge.
+		@param chargeAmps Charging current while a primary source feeds the bus.
+		*/
+		size_t add_battery(electrical_bus& bus, double capacityAh, double fullVolts, double chargeAmps) {
+			auto id = add_source(bus, true);
+			sources_[id].battery = true;
+			sources_[id].capacityAh = capacityAh;
+			sources_[id].fullVolts = fullVolts;
+			sources_[id].chargeAmps = chargeAmps;
+			sources_[id].volts = battery_volts(sources_[id]);
+			return id;
+		}
+
+		/**
+		add_tie
+		A switch joining two buses, open until set_tie closes it.
+		*/
+		size_t add_tie(electrical_bus& a, electrical_bus& b) {
+			ties_.push_back({ a.index_, b.index_, false });
+			a.ties_.push_back(ties_.size() - 1);
+			b.ties_.push_back(ties_.size() - 1);
+			return ties_.size() - 1;
+		}
+
+		void set_tie(size_t id, bool closed) {
+			auto& t = ties_[id];
+			if (t.closed == closed) return;
+			t.closed = closed;
+			mark(t.a);
+			mark(t.b);
+		}
+
+		void set_source_connected(size_t id, bool connected) {
+			auto& s = sources_[id];
+			if (s.connected == connected) return;
+			s.connected = connected;
+			mark(s.bus);
+		}
+
+		void set_source_volts(size_t id, double volts) {
+			auto& s = sources_[id];
+			if (s.volts == volts) return;
+			s.volts = volts;
+			if (s.connected) mark(s.bus);
+		}
+
+		double	battery_level(size_t id) const { return sources_[id].level; }
+		void	set_battery_level(size_t id, double level) {
+			auto& s = sources_[id];
+			s.level = fmax(0.0, fmin(1.0, level));
+			set_source_volts(id, battery_volts(s));
+		}
+
+		/**
+		is_supplying
+		True if source 'id' fed any bus at the last solve.
+		*/
+		bool is_supplying(size_t id) const { return sources_[id].supplying > 0; }
+
+		/**
+		step
+		Updates bus loads, trips overloaded breakers, runs the batteries and re-solves the groups
+		touched since the last step.
+		*/
+		void step(double dt) {
+			for (auto& b : buses_) {
+				auto load = b->update_load();
+				if ((b->breakerAmps_ > 0.0) && !b->isTripped_ && (load > b->breakerAmps_)) {
+					b->isTripped_ = true;
+					mark_with_ties(b->index_);
+				}
+			}
+
+			for (size_t i = 0; i < sources_.size(); i++) {
+				if (sources_[i].battery) step_battery(i, dt);
+			}
+
+			solve();
+		}
+
+		/**
+		solve
+		Re-solves the connected groups of the marked buses.  step calls this, call it directly to
+		apply a switch event right away.
+		*/
+		void solve() {
+			if (dirty_.empty()) return;
+			pass_++;
+
+			for (size_t i = 0; i < dirty_.size(); i++) {
+				auto start = dirty_[i];
+				isDirty_[start] = false;
+				if (visited_[start] == pass_) continue;
+				solve_group(start);
+			}
+			dirty_.clear();
+		}
+
+		double total_load() const {
+			double load = 0.0;
+			for (auto& b : buses_) load += b->load_;
+			return load;
+		}
+
+	private:
+		friend class electrical_bus;
+
+		struct source {
+			size_t	bus;
+			bool	isBackup;
+			bool	connected{ false };
+			double	volts{ 0.0 };
+			int		supplying{ 0 };		// Buses fed at the last solve.
+
+			bool	battery{ false };
+			double	level{ 1.0 };
+			double	capacityAh{ 0.0 };
+			double	fullVolts{ 0.0 };
+			double	chargeAmps{ 0.0 };
+		};
+
+		struct tie {
+			size_t	a;
+			size_t	b;
+			bool	closed;
+		};
+
+		void mark(size_t bus) {
+			if (isDirty_.size() <= bus) {
+				isDirty_.resize(bus + 1, false);
+				visited_.resize(bus + 1, 0);
+			}
+			if (isDirty_[bus]) return;
+			isDirty_[bus] = true;
+			dirty_.push_back(bus);
+		}
+
+		// The bus and its tie neighbours, for changes that split or join a group.
+		void mark_with_ties(size_t bus) {
+			mark(bus);
+			for (auto t : buses_[bus]->ties_) {
+				if (ties_[t].closed) mark((ties_[t].a == bus) ? ties_[t].b : ties_[t].a);
+			}
+		}
+
+		bool is_live(size_t bus) const { return !buses_[bus]->isTripped_; }
+
+		void solve_group(size_t start) {
+			// Collect the group through closed ties.  A tripped bus is a group of its own.
+			group_.clear();
+			group_.push_back(start);
+			visited_[start] = pass_;
+			for (size_t i = 0; i < group_.size(); i++) {
+				auto& b = *buses_[group_[i]];
+				if (!is_live(b.index_)) continue;
+
+				for (auto t : b.ties_) {
+					auto& tie = ties_[t];
+					if (!tie.closed) continue;
+					auto other = (tie.a == b.index_) ? tie.b : tie.a;
+					if ((visited_[other] == pass_) || !is_live(other)) continue;
+					visited_[other] = pass_;
+					group_.push_back(other);
+				}
+			}
+
+			// Best primary source, falling back to the best backup.
+			size_t best = SIZE_MAX;
+			size_t backup = SIZE_MAX;
+			if (is_live(start)) {
+				for (auto bi : group_) {
+					for (auto si : buses_[bi]->sources_) {
+						auto& s = sources_[si];
+						if (!s.connected) continue;
+						auto& pick = s.isBackup ? backup : best;
+						if ((pick == SIZE_MAX) || (s.volts > sources_[pick].volts)) pick = si;
+					}
+				}
+			}
+
+			if ((best == SIZE_MAX) || (sources_[best].volts < useableVolts_)) {
+				if (backup != SIZE_MAX) best = backup;
+			}
+
+			auto volts = (best == SIZE_MAX) ? 0.0 : sources_[best].volts;
+			for (auto bi : group_) {
+				auto& b = *buses_[bi];
+				if (b.supply_ != SIZE_MAX) sources_[b.supply_].supplying--;
+				b.supply_ = best;
+				if (best != SIZE_MAX) sources_[best].supplying++;
+				b.set_volts(volts);
+			}
+		}
+
+		void step_battery(size_t id, double dt) {
+			auto& s = sources_[id];
+			if (s.capacityAh <= 0.0) return;
+
+			double amps = 0.0;
+			if (s.supplying > 0) {
+				for (auto& b : buses_) {
+					if (b->supply_ == id) amps += b->load_;
+				}
+			}
+			else {
+				auto& own = *buses_[s.bus];
+				if (s.connected && (own.supply_ != SIZE_MAX) && !sources_[own.supply_].isBackup) amps = -s.chargeAmps;
+			}
+
+			if (amps == 0.0) return;
+			auto level = fmax(0.0, fmin(1.0, s.level - (amps * dt) / (s.capacityAh * 3600.0)));
+			if (level == s.level) return;
+			s.level = level;
+
+			// Quantize so a slowly discharging battery doesn't re-solve its group every frame.
+			auto volts = std::round(battery_volts(s) * 10.0) / 10.0;
+			set_source_volts(id, volts);
+		}
+
+		/**
+		Discharge curve: a short drop from full charge, a long flat plateau, then a knee below 10%.
+		*/
+		static double battery_volts(const source& s) {
+			static const double levels[] = { 0.0,  0.1,  0.9,  1.0 };
+			static const double ratio[]  = { 0.0,  0.88, 0.95, 1.0 };
+
+			for (int i = 1; i < 4; i++) {
+				if (s.level <= levels[i]) {
+					auto f = (s.level - levels[i - 1]) / (levels[i] - levels[i - 1]);
+					return s.fullVolts * (ratio[i - 1] + f * (ratio[i] - ratio[i - 1]));
+				}
+			}
+			return s.fullVolts;
+		}
+
+		double										useableVolts_;
+		std::vector<std::unique_ptr<electrical_bus>>	buses_;		// Pointers, consumers hold references to buses.
+		std::vector<source>							sources_;
+		std::vector<tie>							ties_;
+
+		std::vector<size_t>							dirty_;
+		std::vector<bool>							isDirty_;
+		std::vector<unsigned>						visited_;
+		std::vector<size_t>							group_;
+		unsigned									pass_{ 0 };
+	};
+
+	inline void electrical_bus::reset_breaker()
+	{
+		if (!isTripped_) return;
+		isTripped_ = false;
+		network_.mark_with_ties(index_);
+	}
+}
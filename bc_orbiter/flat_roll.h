@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include "control.h"
+#include "Control.h"
+#include "animation_store.h"
 
 #include <functional>
 
@@ -27,7 +28,7 @@ namespace bc_orbiter {
     * Transforms the UV values of a texture in a loop to achieve the effect of a barrel number wheel.
     * The texture transforms in the 'v' or 'y' axis.  This can be parameterized if needed.
     */
-    class flat_roll :
+    class flat_roll final :
           public control
         , public vc_tex_animation
         , public panel_animation {
@@ -50,32 +51,47 @@ namespace bc_orbiter {
         { }
 
         void vc_step(DEVMESHHANDLE mesh, double simdt) override {
-            anim_.Step(target_state_, simdt);
             vecTrans_.y = texOffset_ * anim_.GetState();
-            TransformUV<DEVMESHHANDLE>(mesh, vcGroup_, vcVerts_, 0.0, vecTrans_);
+            if (vcApplied_.changed(0.0, vecTrans_)) {
+                TransformUV<DEVMESHHANDLE>(mesh, vcGroup_, vcVerts_, 0.0, vecTrans_);
+            }
         }
 
         // panel_animation
         void panel_step(MESHHANDLE mesh, double simdt) override {
-            anim_.Step(target_state_, simdt);
             vecTrans_.y = texOffset_ * anim_.GetState();
-            TransformUV<MESHHANDLE>(mesh, pnlGroup_, pnlVerts_, 0.0, vecTrans_);
+            if (pnlApplied_.changed(0.0, vecTrans_)) {
+                TransformUV<MESHHANDLE>(mesh, pnlGroup_, pnlVerts_, 0.0, vecTrans_);
+            }
             //            sprintf(oapiDebugString(), "T: %+4.4f  Anim: %+4.4f  Slot: %+4.4f", target_state_, anim_.GetState(), (double)slotTransform_.value());
         }
 
         int panel_id() override { return pnlId_; }
 
-        void set_position(double pos) { target_state_ = floor(pos) / 10; }
+        void set_position(double pos) {
+            target_state_ = floor(pos) / 10;
+            anim_.SetTarget(target_state_);
+        }
+
+        /**
+        Texture offset changes smaller than this are not applied.
+        */
+        void set_transform_epsilon(double e) {
+            vcApplied_.set_epsilon(e);
+            pnlApplied_.set_epsilon(e);
+        }
 
     private:
         double          target_state_{ 0.0 };
         double          texOffset_{ 0.0 };
-        animation_wrap  anim_{ 1.0 };
+        animation_handle<state_update_wrap> anim_{ 1.0 };
         VECTOR3         vecTrans_{ 0.0, 0.0, 0.0 };
         UINT			pnlGroup_{ 0 };
         const NTVERTEX* pnlVerts_{ nullptr };
         UINT			vcGroup_{ 0 };
         const NTVERTEX* vcVerts_{ nullptr };
         int             pnlId_;
+        applied_transform<DEVMESHHANDLE>    vcApplied_;
+        applied_transform<MESHHANDLE>       pnlApplied_;
     };
 }
@@ -0,0 +1,141 @@
+//	flight_state - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Orbitersdk.h"
+#include "Tools.h"
+
+namespace bc_orbiter {
+
+	/**
+	flight_state
+	Air data and attitude values the avionics read, taken from Orbiter during vessel::clbkPostStep.
+	Components read it through vessel::GetFlightState rather than querying Orbiter themselves.
+	Each value is fetched the first time it is read in a step and kept until the next step, so a
+	value costs at most one API call per frame however many gauges show it, and values nothing
+	reads that frame cost nothing.
+	*/
+	class flight_state
+	{
+	public:
+		/**
+		Fields, each one Orbiter call.  The derived values are worked out from them on each read.
+		*/
+		enum field : unsigned {
+			PITCH			= 1 << 0,
+			BANK			= 1 << 1,
+			YAW				= 1 << 2,
+			AOA				= 1 << 3,
+			ALTITUDE		= 1 << 4,
+			ALTITUDE_GROUND	= 1 << 5,
+			MACH			= 1 << 6,
+			AIRSPEED		= 1 << 7,
+			ATM_PRESSURE	= 1 << 8,
+			ATM_DENSITY		= 1 << 9,
+			DYN_PRESSURE	= 1 << 10,
+			ANGULAR_VEL		= 1 << 11,
+			VERTICAL_SPEED	= 1 << 12,
+			ALL				= (1 << 13) - 1
+		};
+
+		explicit flight_state(const VESSEL& vessel) : vessel_(vessel) {}
+
+		flight_state(const flight_state&) = delete;
+		flight_state& operator=(const flight_state&) = delete;
+
+		// Attitude (radians).
+		double pitch() const				{ return get(PITCH, pitch_, [this]() { return vessel_.GetPitch(); }); }
+		double bank() const					{ return get(BANK, bank_, [this]() { return vessel_.GetBank(); }); }
+		double yaw() const					{ return get(YAW, yaw_, [this]() { return vessel_.GetYaw(); }); }
+		double aoa() const					{ return get(AOA, aoa_, [this]() { return vessel_.GetAOA(); }); }
+
+		// Altitude (meters).
+		double altitude() const				{ return get(ALTITUDE, altitude_, [this]() { return vessel_.GetAltitude(); }); }		// Mean radius.
+		double altitude_ground() const		{ return get(ALTITUDE_GROUND, altitudeGround_, [this]() { return ground_altitude(); }); }		// Above the surface.
+
+		// Air data.
+		double mach() const					{ return get(MACH, mach_, [this]() { return vessel_.GetMachNumber(); }); }
+		double airspeed() const				{ return get(AIRSPEED, airspeed_, [this]() { return vessel_.GetAirspeed(); }); }			// m/s
+		double atm_pressure() const			{ return get(ATM_PRESSURE, atmPressure_, [this]() { return vessel_.GetAtmPressure(); }); }	// Static pressure (Pa).
+		double atm_density() const			{ return get(ATM_DENSITY, atmDensity_, [this]() { return vessel_.GetAtmDensity(); }); }	// kg/m^3
+		double dyn_pressure() const			{ return get(DYN_PRESSURE, dynPressure_, [this]() { return vessel_.GetDynPressure(); }); }	// Pa
+		const VECTOR3& angular_vel() const	{ return get(ANGULAR_VEL, angularVel_, [this]() { return angular_velocity(); }); }
+
+		// Derived.
+		double keas() const					{ return CalcKeas(mach(), atm_pressure()); }
+		double vertical_speed() const		{ return get(VERTICAL_SPEED, verticalSpeed_, [this]() { return horizon_vertical_speed(); }); }	// m/s
+		double vertical_speed_fpm() const	{ return (vertical_speed() * 3.28084) * 60; }												// feet per minute
+
+		/**
+		Fields fetched since the last reset.
+		*/
+		unsigned fetched() const { return valid_; }
+
+		/**
+		Called by vessel at the start of each clbkPostStep, the next read of each field fetches it again.
+		*/
+		void reset() { valid_ = 0; }
+
+	private:
+		// The value of 'field', fetched into 'value' if this is its first read since the reset.
+		template<typename T, typename F>
+		const T& get(field f, T& value, F fetch) const
+		{
+			if (!(valid_ & f)) {
+				value = fetch();
+				valid_ |= f;
+			}
+			return value;
+		}
+
+		double ground_altitude() const
+		{
+			int res = 0;
+			return vessel_.GetAltitude(AltitudeMode::ALTMODE_GROUND, &res);
+		}
+
+		VECTOR3 angular_velocity() const
+		{
+			VECTOR3 v;
+			vessel_.GetAngularVel(v);
+			return v;
+		}
+
+		double horizon_vertical_speed() const
+		{
+			VECTOR3 v;
+			return vessel_.GetAirspeedVector(FRAME_HORIZON, v) ? v.y : 0.0;
+		}
+
+		const VESSEL&	vessel_;
+		mutable unsigned	valid_{ 0 };
+
+		mutable double	pitch_{ 0.0 };
+		mutable double	bank_{ 0.0 };
+		mutable double	yaw_{ 0.0 };
+		mutable double	aoa_{ 0.0 };
+		mutable double	altitude_{ 0.0 };
+		mutable double	altitudeGround_{ 0.0 };
+		mutable double	mach_{ 0.0 };
+		mutable double	airspeed_{ 0.0 };
+		mutable double	atmPressure_{ 0.0 };
+		mutable double	atmDensity_{ 0.0 };
+		mutable double	dynPressure_{ 0.0 };
+		mutable VECTOR3	angularVel_{ 0.0, 0.0, 0.0 };
+		mutable double	verticalSpeed_{ 0.0 };
+	};
+}
@@ -17,7 +17,8 @@
 #pragma once
 
 #include "signals.h"
-#include "control.h"
+#include "Control.h"
+#include "resource_table.h"
 
 #include <sstream>
 
@@ -25,7 +26,9 @@ namespace bc_orbiter {
 
 	/**
 	Base class for a basic tank that reports level, can be filled via a pump, and can be drawn from.
-	Units is determined by the implementer.
+	Units is determined by the implementer.  The tank itself is a row in the vessel resource_table,
+	which steps filling, continuous draws (set_draw_rate) and boil off for all tanks in one pass; this
+	class is the view the panels and consumers work with.
 
 	Inputs:
 	- slot <- volts level
@@ -35,58 +38,37 @@ namespace bc_orbiter {
 	*/
 	class generic_tank :
 		  public vessel_component
-		, public post_step
 		, public power_consumer
 		, public manage_state
 		, public consumable
 	{
 	public:
-		generic_tank(power_provider& pwr, double capacity, double fillRate) :
-			  power_(pwr)
-			, capacity_(capacity)
-			, fillRate_(fillRate) 
+		generic_tank(resource_table& table, power_provider& pwr, double capacity, double fillRate, double boilOffPerHour = 0.0) :
+			  table_(table)
+			, power_(pwr)
+			, id_(table.add_tank(capacity, fillRate, boilOffPerHour))
 		{
 			power_.attach_consumer(this);
+			table_.set_supply(id_, power_, this, VOLTS_MIN);
+
+			table_.level_signal(id_).attach(slotLevel_);
+			table_.filling_signal(id_).attach(slotIsFilling_);
+			table_.available_signal(id_).attach(slotIsAvailable_);
 		}
 
 		// consumable
-		double level() const override { return current_ / capacity_; }
+		double level() const override { return table_.level(id_); }
 
-		double draw(double amount) override {
-			auto draw_amount = max(0.0, min(current_, amount));
-			SetNewCurrentLevel(current_ - draw_amount);
-			return draw_amount;
-		}
+		double draw(double amount) override { return table_.draw(id_, amount); }
+
+		void set_draw_rate(double perSecond) override { table_.set_draw_rate(id_, perSecond); }
 
 		// power_consumable
 		double amp_draw() const override { 
-			return (IsPowered() && isFilling_) ? AMPS_PUMP : 0.0;
+			return (IsPowered() && table_.is_filling(id_)) ? AMPS_PUMP : 0.0;
 		}
 
-		// post_step
-		virtual void handle_post_step(vessel& vessel, double simt, double simdt, double mjd) override {
-			auto tD = simt - prevTime_;
-
-			if (fabs(tD) > 0.2)
-			{
-				isExternal_ = vessel.IsStoppedOrDocked();
-				if (isExternal_ && IsPowered()) {
-					//sigIsAvailable_.fire(true);
-					UpdateIsAvailable(true);
-
-					if (isFilling_) {
-						FillTank(fillRate_ * simdt);
-					}
-				}
-				else {
-					//sigIsAvailable_.fire(false);
-					UpdateIsAvailable(false);
-					//sigIsFilling_.fire(false);
-					UpdateIsFilling(false);
-				}
-				prevTime_ = simt;
-			}
-		}
+		bool reports_draw() const override { return true; }
 
 		// manage_state
 		bool handle_load_state(vessel& vessel, const std::string& line) override {
@@ -94,21 +76,17 @@ namespace bc_orbiter {
 
 			std::istringstream in(line);
 			double amount;
-			in >> amount >> isFilling_;
-			current_ = amount * capacity_;
-			current_ = fmax(0.0, current_);
-			current_ = fmin(capacity_, current_);
-			//sigIsFilling_.fire((isFilling_ == 1) ? true : false);
-			UpdateIsFilling((isFilling_ == 1) ? true : false);
-			UpdateLevel(current_ / capacity_);
-			//sigLevel_.fire(current_ / capacity_);
+			bool isFilling;
+			in >> amount >> isFilling;
+			table_.load(id_, amount * table_.capacity(id_), isFilling);
+			power_.draw_changed(this);
 				
 			return true;
 		}
 
 		std::string handle_save_state(vessel& vessel) override {
 			std::ostringstream os;
-			os << current_ << " " << isFilling_;
+			os << table_.amount(id_) << " " << table_.is_filling(id_);
 			return os.str();
 		}
 
@@ -118,34 +96,9 @@ namespace bc_orbiter {
 				power_.volts_available() > VOLTS_MIN;
 		}
 
-		void FillTank(double amount) {
-			SetNewCurrentLevel(min(current_ + amount, capacity_));
-
-			if (current_ == capacity_) {
-				isFilling_ = false;
-				//sigIsFilling_.fire(isFilling_);
-				UpdateIsFilling(isFilling_);
-			}
-
-			//sigLevel_.fire(current_ / capacity_);		// 0 to 1 range
-			UpdateLevel(current_ / capacity_);
-		}
-
 		void ToggleFilling() {
-			if (isFilling_) {
-				isFilling_ = false;
-			}
-			else {
-				if (IsPowered() && isExternal_) {
-					isFilling_ = true;
-				}
-			}
-			UpdateIsFilling(isFilling_);
-		}
-
-		void SetNewCurrentLevel(double new_current) {
-			current_ = new_current;
-			UpdateLevel(current_ / capacity_);
+			table_.set_filling(id_, !table_.is_filling(id_));
+			power_.draw_changed(this);
 		}
 
 		virtual void UpdateLevel(double l) {};
@@ -153,19 +106,16 @@ namespace bc_orbiter {
 		virtual void UpdateIsAvailable(bool b) {};
 
 	private:
+		resource_table&			table_;
 		power_provider&			power_;
 
-		const double			VOLTS_MIN = 24.0;
-		const double			AMPS_PUMP = 4.0;
-
-		signal<bool>			sigIsFilling_;
+		static constexpr double	VOLTS_MIN = 24.0;
+		static constexpr double	AMPS_PUMP = 4.0;
 
-		bool					isFilling_	{ false };
-		bool					isExternal_	{ false };
-		double					prevTime_	{ 0.0 };
+		resource_table::id		id_;
 
-		double					capacity_;
-		double					current_	{ 0.0 };
-		double					fillRate_;
+		slot<double>			slotLevel_			{ [&](double l) { UpdateLevel(l); } };
+		slot<bool>				slotIsFilling_		{ [&](bool b) { UpdateIsFilling(b); } };
+		slot<bool>				slotIsAvailable_	{ [&](bool b) { UpdateIsAvailable(b); } };
 	};
 }
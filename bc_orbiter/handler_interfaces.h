@@ -45,13 +45,22 @@ namespace bc_orbiter {
 		virtual ~set_class_caps() {};
 	};
 
+	/**
+	step_rate
+	Nominal rate a post_step component wants to be called at.  Slower rates are staggered
+	by the vessel so components in the same group do not all run on the same frame.
+	*/
+	enum class step_rate { frame, hz50, hz10, hz1 };
+
 	/**
 	post_step
 	Indicates the class participates in postStep callbacks.  The class must implement
-	the post step handler.
+	the post step handler.  Override post_step_rate to be called less often than every
+	frame, in which case simdt passed to handle_post_step is the time since the last call.
 	*/
 	struct post_step {
 		virtual void handle_post_step(vessel& vessel, double simt, double simdt, double mjd) = 0;
+		virtual step_rate post_step_rate() const { return step_rate::frame; }
 		virtual ~post_step() {};
 	};
 
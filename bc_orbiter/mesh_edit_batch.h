@@ -0,0 +1,190 @@
+//	mesh_edit_batch - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Orbitersdk.h"
+
+#include <array>
+#include <cmath>
+
+namespace bc_orbiter {
+
+	/**
+	mesh_edit_batch
+	Collects the four vertex group edits controls make each frame (see TranslateMesh, RotateMesh,
+	TransformUV in Tools.h) in a fixed arena and applies them in one pass when flushed.  An edit
+	to a mesh group that already has a pending edit of the same kind replaces it, so only the latest
+	edit per group reaches oapiEditMeshGroup.  Nothing is allocated after startup.
+
+	T is MESHHANDLE (panels) or DEVMESHHANDLE (VC), there is one batch of each for the module.
+	*/
+	template<typename T>
+	class mesh_edit_batch
+	{
+	public:
+		static const size_t CAPACITY = 256;
+		static const DWORD  VERTS = 4;
+
+		static mesh_edit_batch& instance()
+		{
+			static mesh_edit_batch batch;
+			return batch;
+		}
+
+		/**
+		edit
+		Returns the four vertex buffer to fill for the edit of 'group' in 'mesh'.  'flags' is the
+		GRPEDIT_* value used when the edit is applied.
+		*/
+		NTVERTEX* edit(T mesh, UINT group, DWORD flags)
+		{
+			auto key = mesh_key(mesh);
+			for (size_t i = 0; i < count_; i++) {		// Pending edits per frame are few, a scan beats hashing here.
+				auto& e = edits_[i];
+				if ((e.key == key) && (e.group == group) && (e.flags == flags)) {
+					merged_++;
+					return e.verts;
+				}
+			}
+
+			if (count_ == CAPACITY) flush();
+
+			auto& e = edits_[count_++];
+			e.mesh = mesh;
+			e.key = key;
+			e.group = group;
+			e.flags = flags;
+			return e.verts;
+		}
+
+		void flush()
+		{
+			for (size_t i = 0; i < count_; i++) {
+				auto& e = edits_[i];
+
+				GROUPEDITSPEC change{};
+				change.flags = e.flags;
+				change.nVtx = VERTS;
+				change.vIdx = NULL; //Just use the mesh order
+				change.Vtx = e.verts;
+				oapiEditMeshGroup(e.mesh, e.group, &change);
+			}
+
+			issued_ += count_;
+			count_ = 0;
+		}
+
+		/**
+		skip
+		Called by applied_transform when an edit is dropped because nothing moved.
+		*/
+		void skip() { skipped_++; }
+
+		/**
+		invalidate
+		Call when the meshes are (re)loaded, every applied_transform applies its next edit.
+		*/
+		void invalidate() { generation_++; }
+
+		unsigned generation() const { return generation_; }
+
+		size_t issued() const	{ return issued_; }
+		size_t merged() const	{ return merged_; }
+		size_t skipped() const	{ return skipped_; }
+
+	private:
+		mesh_edit_batch() = default;
+
+		static const void* mesh_key(T mesh) { return static_cast<MESHHANDLE>(mesh); }
+
+		struct pending_edit {
+			T			mesh{};
+			const void*	key{ nullptr };
+			UINT		group{ 0 };
+			DWORD		flags{ 0 };
+			NTVERTEX	verts[VERTS];
+		};
+
+		std::array<pending_edit, CAPACITY>	edits_;
+		size_t								count_{ 0 };
+		size_t								issued_{ 0 };
+		size_t								merged_{ 0 };
+		size_t								skipped_{ 0 };
+		unsigned							generation_{ 1 };
+	};
+
+	/**
+	applied_transform
+	Remembers the last rotation and translation a control applied to one mesh group.  changed returns
+	false, and counts a skipped edit, while the new transform is within epsilon of that one, so gauges
+	that are not moving cost nothing.
+	*/
+	template<typename T>
+	class applied_transform
+	{
+	public:
+		static constexpr double DEFAULT_EPSILON = 1e-6;
+
+		bool changed(double angle, const VECTOR3& trans)
+		{
+			auto& batch = mesh_edit_batch<T>::instance();
+			if ((generation_ == batch.generation()) &&
+				(std::abs(angle - angle_) <= epsilon_) &&
+				(std::abs(trans.x - x_) <= epsilon_) &&
+				(std::abs(trans.y - y_) <= epsilon_)) {
+				batch.skip();
+				return false;
+			}
+
+			generation_ = batch.generation();
+			angle_ = angle;
+			x_ = trans.x;
+			y_ = trans.y;
+			return true;
+		}
+
+		void set_epsilon(double e) { epsilon_ = e; }
+
+	private:
+		double		epsilon_{ DEFAULT_EPSILON };
+		double		angle_{ 0.0 };
+		double		x_{ 0.0 };
+		double		y_{ 0.0 };
+		unsigned	generation_{ 0 };
+	};
+
+	/**
+	flush_mesh_edits
+	Applies all pending VC and panel mesh edits.
+	*/
+	inline void flush_mesh_edits()
+	{
+		mesh_edit_batch<DEVMESHHANDLE>::instance().flush();
+		mesh_edit_batch<MESHHANDLE>::instance().flush();
+	}
+
+	inline size_t skipped_mesh_edits()
+	{
+		return mesh_edit_batch<DEVMESHHANDLE>::instance().skipped() + mesh_edit_batch<MESHHANDLE>::instance().skipped();
+	}
+
+	inline void invalidate_mesh_edits()
+	{
+		mesh_edit_batch<DEVMESHHANDLE>::instance().invalidate();
+		mesh_edit_batch<MESHHANDLE>::instance().invalidate();
+	}
+}
@@ -30,7 +30,7 @@ namespace bc_orbiter {
     'x' axis 'offset' amount to move from OFF to ON.
     The state of the UI is control via a slot input.
     **/
-    class on_off_display :
+    class on_off_display final :
         public control,
         public vc_event_target,
         public panel_event_target
@@ -54,17 +54,7 @@ namespace bc_orbiter {
         { }
 
         void on_vc_redraw(DEVMESHHANDLE vcMesh) override {
-            NTVERTEX* delta = new NTVERTEX[4];
-
-            TransformUV2d(vcVerts_, delta, 4, _V(state_ ? offset_ : 0.0, 0.0, 0.0), 0.0);
-
-            GROUPEDITSPEC change{};
-            change.flags = GRPEDIT_VTXTEX;
-            change.nVtx = 4;
-            change.vIdx = NULL; //Just use the mesh order
-            change.Vtx = delta;
-            auto res = oapiEditMeshGroup(vcMesh, vcGroupId_, &change);
-            delete[] delta;
+            TransformUV<DEVMESHHANDLE>(vcMesh, vcGroupId_, vcVerts_, 0.0, _V(state_ ? offset_ : 0.0, 0.0, 0.0));
         }
 
         void on_panel_redraw(MESHHANDLE meshPanel) override {
@@ -77,8 +67,9 @@ namespace bc_orbiter {
         int panel_redraw_flags() { return PANEL_REDRAW_USER; }
 
         void set_state(bool s) {
+            auto changed = (s != state_);
             state_ = s;
-            oapiTriggerRedrawArea(pnlId_, 0, get_id());
+            request_redraw_if(changed, redrawStamp_, pnlId_);
         }
 
         int panel_id() override { return pnlId_; }
@@ -90,5 +81,6 @@ namespace bc_orbiter {
         const NTVERTEX*     pnlVerts_;
         bool                state_{ false };
         double              offset_{ 0.0 };
+        unsigned            redrawStamp_{ 0 };
     };
 }
\ No newline at end of file
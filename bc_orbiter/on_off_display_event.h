@@ -30,7 +30,7 @@ namespace bc_orbiter {
     'x' axis 'offset' amount to move from OFF to ON.
     The state of the UI is control via a slot input.
     **/
-    class on_off_display_event : 
+    class on_off_display_event final : 
         public control, 
         public vc_event_target, 
         public panel_event_target {
@@ -57,7 +57,7 @@ namespace bc_orbiter {
             slotState_([&](double v) {
                 if (state_ != v) {
                     state_ = v;
-                    oapiTriggerRedrawArea(0, 0, get_id());
+                    request_redraw(0);
                 }
             }
             ) { }
@@ -69,15 +69,7 @@ namespace bc_orbiter {
             double      vc_event_radius()	override { return vcRadius_; }
 
             void on_vc_redraw(DEVMESHHANDLE vcMesh) override {
-                NTVERTEX* delta = new NTVERTEX[4];
-                TransformUV2d(vcVerts_, delta, 4, _V(state_ ? offset_ : 0.0, 0.0, 0.0), 0.0);
-                GROUPEDITSPEC change{};
-                change.flags = GRPEDIT_VTXTEX;
-                change.nVtx = 4;
-                change.vIdx = NULL; //Just use the mesh order
-                change.Vtx = delta;
-                auto res = oapiEditMeshGroup(vcMesh, vcGroupId_, &change);
-                delete[] delta;
+                TransformUV<DEVMESHHANDLE>(vcMesh, vcGroupId_, vcVerts_, 0.0, _V(state_ ? offset_ : 0.0, 0.0, 0.0));
             }
 
             // panel_event_target
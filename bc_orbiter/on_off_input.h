@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include "control.h"
+#include "Control.h"
+#include "animation_store.h"
 
 namespace bc_orbiter {
 
@@ -47,7 +48,7 @@ namespace bc_orbiter {
 	Since much of the metadata will be the same, many of the metrics are provided via a control_data structure
 	that can be reused for many control. A bank of switches for example.
 	*/
-	class on_off_input :
+	class on_off_input final :
         public control,
         public vc_animation,
         public vc_event_target,
@@ -87,9 +88,10 @@ namespace bc_orbiter {
             animation_group*    vc_animation_group()        override { return &vcAnimGroup_; }
             double              vc_animation_speed() const  override { return vcData_.animSpeed; }
             double vc_step(double simdt) override {
-                animVC_.Step(state_ ? 1.0 : 0.0, simdt);
-                return animVC_.GetState();
+                vcApplied_ = animVC_.GetState();
+                return vcApplied_;
             }
+            bool vc_at_rest() const override { return animVC_.GetState() == vcApplied_; }
 
         // vc_event_target
         VECTOR3             vc_event_location()         override { return vcAnimGroup_.location_; }
@@ -110,16 +112,18 @@ namespace bc_orbiter {
         // event_target
         bool on_event(int id, int event) override {
             state_ = !state_;
+            animVC_.SetTarget(state_ ? 1.0 : 0.0);
             fire();
             return true;
         }
 
-        void attach_on_change(const std::function<void()>& func) override {
+        void attach_on_change(const delegate<void()>& func) override {
             attach(func);
         }
 
         void toggle_state() {
             state_ = !state_;
+            animVC_.SetTarget(state_ ? 1.0 : 0.0);
             fire();
             oapiTriggerRedrawArea(0, 0, get_id());
         }
@@ -149,7 +153,8 @@ namespace bc_orbiter {
         const NTVERTEX*     pnlVerts_;
         RECT                pnlRect_;
         double              pnlOffset_;
-        animation_target    animVC_;
+        animation_handle<state_update_target> animVC_;
+        double              vcApplied_{ -1.0 };     // Last state handed to the VC animation.
         int                 pnlId_;
     };
 }
\ No newline at end of file
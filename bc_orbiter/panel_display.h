@@ -16,12 +16,12 @@
 
 #pragma once
 
-#include "control.h"
+#include "Control.h"
 #include "Tools.h"
 
 namespace bc_orbiter {
 
-    class panel_display :
+    class panel_display final :
         public control,
         public panel_animation {
     public:
@@ -0,0 +1,195 @@
+//	profiler - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Orbitersdk.h"
+
+#ifdef BCO_PROFILE
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#endif
+
+namespace bc_orbiter {
+
+	/**
+	profiler
+	Opt-in timing of the handlers called by vessel.  Define BCO_PROFILE to enable it, otherwise
+	profiler and profile_scope are empty and compile away.
+
+	Each handler is keyed on its object and category (post_step, draw_hud, redraw).  The last
+	SAMPLES timings are kept per entry for a rolling min/mean/p99, the slowest entries are shown
+	in the debug string once a second, and the full table can be written as CSV.
+	*/
+#ifdef BCO_PROFILE
+	class profiler
+	{
+	public:
+		static const size_t SAMPLES = 256;
+
+		struct stats {
+			double min{ 0.0 };
+			double mean{ 0.0 };
+			double p99{ 0.0 };
+		};
+
+		struct entry {
+			std::string					category;
+			std::string					name;
+			std::array<double, SAMPLES>	samples{};		// microseconds
+			size_t						count{ 0 };		// total samples recorded
+
+			stats get_stats() const {
+				stats s;
+				auto n = std::min(count, SAMPLES);
+				if (n == 0) return s;
+
+				std::vector<double> sorted(samples.begin(), samples.begin() + n);
+				std::sort(sorted.begin(), sorted.end());
+
+				double sum = 0.0;
+				for (auto v : sorted) sum += v;
+
+				s.min = sorted.front();
+				s.mean = sum / n;
+				s.p99 = sorted[std::min(n - 1, (n * 99) / 100)];
+				return s;
+			}
+		};
+
+		template<typename T>
+		entry& get_entry(const char* category, T* obj) {
+			auto key = std::make_pair(static_cast<const void*>(obj), category);
+			auto it = index_.find(key);
+			if (it != index_.end()) return entries_[it->second];
+
+			index_[key] = entries_.size();
+			entries_.push_back(entry());
+			entries_.back().category = category;
+			entries_.back().name = typeid(*obj).name();
+			return entries_.back();
+		}
+
+		void record(entry& e, double micros) {
+			e.samples[e.count % SAMPLES] = micros;
+			e.count++;
+		}
+
+		/**
+		show
+		Writes the three most expensive entries by mean to the debug string, once per second of system time.
+		*/
+		void show() {
+			auto now = oapiGetSysTime();
+			if ((now - lastShow_) < 1.0) return;
+			lastShow_ = now;
+
+			std::vector<std::pair<double, size_t>> order;
+			for (size_t i = 0; i < entries_.size(); i++) order.emplace_back(entries_[i].get_stats().mean, i);
+			std::sort(order.begin(), order.end(), [](auto& a, auto& b) { return a.first > b.first; });
+
+			std::string out;
+			for (size_t i = 0; i < std::min<size_t>(3, order.size()); i++) {
+				auto& e = entries_[order[i].second];
+				auto s = e.get_stats();
+				char buf[96];
+				snprintf(buf, sizeof(buf), "%s %s %.0f/%.0f/%.0fus  ", e.category.c_str(), e.name.c_str(), s.min, s.mean, s.p99);
+				out += buf;
+			}
+
+			snprintf(oapiDebugString(), 256, "%s", out.c_str());		// Always terminated, three entries can pass 255.
+		}
+
+		/**
+		write_csv
+		Writes category, name, samples, min, mean and p99 (microseconds) for each entry
+		to <vessel name>_profile.csv in the Orbiter working folder.
+		*/
+		bool write_csv(const VESSEL* vessel) const {
+			if (entries_.empty()) return false;
+
+			std::ofstream out(std::string(vessel->GetName()) + "_profile.csv");
+			if (!out) return false;
+
+			out << "category,name,samples,min_us,mean_us,p99_us\n";
+			for (auto& e : entries_) {
+				auto s = e.get_stats();
+				out << e.category << "," << e.name << "," << e.count << ","
+					<< s.min << "," << s.mean << "," << s.p99 << "\n";
+			}
+			return true;
+		}
+
+	private:
+		struct key_hash {
+			size_t operator()(const std::pair<const void*, const char*>& k) const {
+				return std::hash<const void*>()(k.first) ^ (std::hash<const void*>()(k.second) << 1);
+			}
+		};
+
+		std::deque<entry>	entries_;		// deque, references must survive nested scopes adding entries.
+		std::unordered_map<std::pair<const void*, const char*>, size_t, key_hash> index_;
+		double				lastShow_{ 0.0 };
+	};
+
+	/**
+	profile_scope
+	Times its own lifetime and records it against the object's profiler entry.
+	*/
+	class profile_scope
+	{
+	public:
+		template<typename T>
+		profile_scope(profiler& prof, const char* category, T* obj) :
+			prof_(prof),
+			entry_(prof.get_entry(category, obj)),
+			start_(std::chrono::steady_clock::now())
+		{}
+
+		~profile_scope() {
+			auto dt = std::chrono::steady_clock::now() - start_;
+			prof_.record(entry_, std::chrono::duration<double, std::micro>(dt).count());
+		}
+
+	private:
+		profiler&								prof_;
+		profiler::entry&						entry_;
+		std::chrono::steady_clock::time_point	start_;
+	};
+#else
+	class profiler
+	{
+	public:
+		void show() {}
+		bool write_csv(const VESSEL*) const { return false; }
+	};
+
+	class profile_scope
+	{
+	public:
+		template<typename T>
+		profile_scope(profiler&, const char*, T*) {}
+	};
+#endif
+}
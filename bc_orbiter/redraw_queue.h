@@ -0,0 +1,109 @@
+//	redraw_queue - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "OrbiterAPI.h"
+
+#include <vector>
+
+namespace bc_orbiter {
+
+	/**
+	redraw_queue
+	Collects redraw requests from a vessel's controls during a frame and triggers each area once
+	when the vessel flushes it.  Each vessel owns one, so two vessels of the same class keep their
+	requests and reloads apart; controls reach it through control::request_redraw.  Requests for an area already in the queue are merged.  Controls that use request_if
+	also skip the request entirely when their visible state has not changed, unless the visuals
+	have been reloaded since they last drew (see invalidate).
+	*/
+	class redraw_queue
+	{
+	public:
+		/**
+		request
+		Queue a redraw of area 'id' on panel 'pnlId'.
+		*/
+		void request(int pnlId, int id)
+		{
+			if (id < 0) return;
+			if (static_cast<size_t>(id) >= queued_.size()) queued_.resize(id + 1, false);
+
+			if (queued_[id]) {
+				merged_++;
+				return;
+			}
+
+			queued_[id] = true;
+			requests_.push_back({ pnlId, id });
+		}
+
+		/**
+		request_if
+		Queue a redraw only if 'changed' is true or the visuals were reloaded since 'stamp' was
+		last updated.  Otherwise the request is counted as suppressed.
+		@param stamp Per control value, updated when a request is let through.
+		*/
+		void request_if(bool changed, unsigned& stamp, int pnlId, int id)
+		{
+			if (!changed && (stamp == generation_)) {
+				suppressed_++;
+				return;
+			}
+
+			stamp = generation_;
+			request(pnlId, id);
+		}
+
+		/**
+		invalidate
+		Call when the VC or panel is (re)loaded so the next request from every control goes through.
+		*/
+		void invalidate() { generation_++; }
+
+		void flush()
+		{
+			if (requests_.empty()) return;
+
+			// Swap out first, a redraw may call back into request.
+			flushing_.swap(requests_);
+			for (auto& r : flushing_) {
+				queued_[r.id] = false;
+				oapiTriggerRedrawArea(r.pnlId, 0, r.id);
+				issued_++;
+			}
+			flushing_.clear();
+		}
+
+		size_t issued() const		{ return issued_; }
+		size_t merged() const		{ return merged_; }
+		size_t suppressed() const	{ return suppressed_; }
+
+	private:
+		struct redraw_request {
+			int pnlId;
+			int id;
+		};
+
+		std::vector<redraw_request>	requests_;
+		std::vector<redraw_request>	flushing_;
+		std::vector<bool>			queued_;
+		unsigned					generation_{ 1 };
+		size_t						issued_{ 0 };
+		size_t						merged_{ 0 };
+		size_t						suppressed_{ 0 };
+	};
+}
@@ -0,0 +1,231 @@
+//	resource_table - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Orbitersdk.h"
+#include "handler_interfaces.h"
+#include "Control.h"
+#include "signals.h"
+#include "vessel.h"
+#include "consumable_flow.h"
+
+#include <deque>
+#include <vector>
+
+namespace bc_orbiter {
+
+	/**
+	resource_table
+	Holds every tank of the vessel (capacity, contents, flows, fill pump and its supply) in one
+	table and steps them all in a single pass with integrate_flow.  Components that own a tank
+	(see generic_tank) are views that keep its id.
+
+	A tank can be bound to an Orbiter propellant resource, its contents are then read from and
+	written back to the propellant so engine burn is seen by the table.
+
+	Level signals (0 to 1) only fire when the level has moved at least the tank quantum since the
+	last fire, or reaches empty or full.  The filling and available signals fire on change.
+	*/
+	class resource_table :
+		  public vessel_component
+		, public post_step
+	{
+	public:
+		using id = size_t;
+
+		static constexpr double DEFAULT_QUANTUM = 0.001;
+
+		/**
+		add_tank
+		@param capacity Capacity in the units of the tank.
+		@param fillRate Pump rate in units per second.
+		@param boilOffPerHour Fraction of the contents lost per hour.
+		@param quantum Level change (0 to 1) that fires the level signal.
+		*/
+		id add_tank(double capacity, double fillRate, double boilOffPerHour = 0.0, double quantum = DEFAULT_QUANTUM)
+		{
+			tank t;
+			t.capacity = capacity;
+			t.fillRate = fillRate;
+			t.boilOff = boilOffPerHour / 3600;
+			t.quantum = quantum;
+			tanks_.push_back(t);
+			signals_.emplace_back();
+			return tanks_.size() - 1;
+		}
+
+		/**
+		set_supply
+		The fill pump runs only while 'pwr' has more than 'minVolts' and the vessel is stopped or docked.
+		'consumer' is told to the provider through draw_changed when the pump stops by itself.
+		*/
+		void set_supply(id i, power_provider& pwr, power_consumer* consumer, double minVolts)
+		{
+			auto& t = tanks_[i];
+			t.power = &pwr;
+			t.consumer = consumer;
+			t.minVolts = minVolts;
+		}
+
+		void bind_propellant(id i, PROPELLANT_HANDLE ph)	{ tanks_[i].propellant = ph; tanks_[i].published = -1.0; }
+
+		/** Continuous draws stop at 'floor' units. */
+		void set_draw_floor(id i, double floor)			{ tanks_[i].drawFloor = floor; }
+		void set_draw_rate(id i, double perSecond)		{ tanks_[i].drawRate = fmax(0.0, perSecond); }
+
+		/**
+		draw
+		Removes 'amount' right away, returns the amount actually drawn.
+		*/
+		double draw(id i, double amount)
+		{
+			auto& t = tanks_[i];
+			auto drawn = fmax(0.0, fmin(t.amount, amount));
+			t.amount -= drawn;
+			return drawn;
+		}
+
+		/**
+		set_filling
+		Starts or stops the fill pump, it will not start without supply.  Returns the pump state.
+		*/
+		bool set_filling(id i, bool on)
+		{
+			auto& t = tanks_[i];
+			t.isFilling = on && t.isSupplied;
+			signals_[i].filling.fire(t.isFilling);
+			return t.isFilling;
+		}
+
+		/** Sets the contents (units) and pump state when loading, both are published on the next step. */
+		void load(id i, double amount, bool isFilling)
+		{
+			auto& t = tanks_[i];
+			t.amount = fmax(0.0, fmin(t.capacity, amount));
+			t.isFilling = isFilling;
+			t.published = -1.0;
+			signals_[i].filling.fire(t.isFilling);
+		}
+
+		double amount(id i) const		{ return tanks_[i].amount; }
+		double capacity(id i) const		{ return tanks_[i].capacity; }
+		double level(id i) const		{ return tanks_[i].amount / tanks_[i].capacity; }
+		bool is_filling(id i) const		{ return tanks_[i].isFilling; }
+		bool is_supplied(id i) const	{ return tanks_[i].isSupplied; }
+
+		signal<double>& level_signal(id i)		{ return signals_[i].level; }
+		signal<bool>& filling_signal(id i)		{ return signals_[i].filling; }
+		signal<bool>& available_signal(id i)	{ return signals_[i].available; }
+
+		// post_step
+		step_rate post_step_rate() const override { return step_rate::hz10; }
+
+		void handle_post_step(vessel& vessel, double simt, double simdt, double mjd) override
+		{
+			auto isExternal = vessel.IsStoppedOrDocked();
+
+			// Tanks share a few providers, ask each one once per pass.
+			const power_provider* lastPower = nullptr;
+			double lastVolts = 0.0;
+
+			for (id i = 0; i < tanks_.size(); i++) {
+				auto& t = tanks_[i];
+
+				if (t.propellant != nullptr) t.amount = vessel.GetPropellantMass(t.propellant);
+
+				auto isSupplied = isExternal;
+				if (isSupplied && (t.power != nullptr)) {
+					if (t.power != lastPower) {
+						lastPower = t.power;
+						lastVolts = t.power->volts_available();
+					}
+					isSupplied = lastVolts > t.minVolts;
+				}
+
+				if (isSupplied != t.isSupplied) {
+					t.isSupplied = isSupplied;
+					signals_[i].available.fire(isSupplied);
+				}
+
+				if (t.isFilling && !isSupplied) stop_filling(i);
+
+				auto isDrawing = (t.drawRate > 0.0) && (t.amount > t.drawFloor);
+				auto floor = isDrawing ? t.drawFloor : 0.0;
+
+				flow_rates rates;
+				rates.fill = t.isFilling ? t.fillRate : 0.0;
+				rates.draw = isDrawing ? t.drawRate : 0.0;
+				rates.boilOff = t.boilOff;
+
+				if ((rates.fill > 0.0) || (rates.draw > 0.0) || (rates.boilOff > 0.0)) {
+					auto flow = integrate_flow(t.amount - floor, t.capacity - floor, rates, simdt);
+					t.amount = floor + flow.level;
+					if (t.propellant != nullptr) vessel.SetPropellantMass(t.propellant, t.amount);
+					if (flow.fullAt >= 0.0) stop_filling(i);
+				}
+
+				publish(i);
+			}
+		}
+
+	private:
+		struct tank {
+			double				capacity{ 1.0 };
+			double				amount{ 0.0 };
+			double				fillRate{ 0.0 };
+			double				drawRate{ 0.0 };
+			double				drawFloor{ 0.0 };
+			double				boilOff{ 0.0 };			// Fraction per second.
+			double				quantum{ DEFAULT_QUANTUM };
+			double				published{ -1.0 };		// Last level fired, negative to force the next.
+			double				minVolts{ 0.0 };
+			power_provider*		power{ nullptr };
+			power_consumer*		consumer{ nullptr };
+			PROPELLANT_HANDLE	propellant{ nullptr };
+			bool				isFilling{ false };
+			bool				isSupplied{ false };
+		};
+
+		struct tank_signals {
+			signal<double>	level;
+			signal<bool>	filling;
+			signal<bool>	available;
+		};
+
+		void stop_filling(id i)
+		{
+			auto& t = tanks_[i];
+			t.isFilling = false;
+			signals_[i].filling.fire(false);
+			if ((t.power != nullptr) && (t.consumer != nullptr)) t.power->draw_changed(t.consumer);
+		}
+
+		void publish(id i)
+		{
+			auto& t = tanks_[i];
+			auto l = t.amount / t.capacity;
+			auto isEnd = ((l == 0.0) || (l == 1.0)) && (l != t.published);
+			if (isEnd || (fabs(l - t.published) >= t.quantum)) {
+				t.published = l;
+				signals_[i].level.fire(l);
+			}
+		}
+
+		std::vector<tank>			tanks_;
+		std::deque<tank_signals>	signals_;		// Signals are attached to by address, the deque keeps them in place.
+	};
+}
@@ -16,7 +16,9 @@
 
 #pragma once
 
-#include "control.h"
+#include "Control.h"
+#include "animation_store.h"
+
 namespace bc_orbiter {
 
 
@@ -34,7 +36,7 @@ namespace bc_orbiter {
     * convert the signal to a 0 to 1 value.  The angle and speed for both are the same.
     */
     template<typename Tanim>
-    class rotary_display : 
+    class rotary_display final : 
         public control,
         public vc_animation,
         public panel_animation
@@ -68,25 +70,34 @@ namespace bc_orbiter {
 //        IAnimationState*    vc_animation_state() override { return this; }
         double              vc_animation_speed() const override { return animSpeed_; }
         double vc_step(double simdt) override {
-            anim_.Step(state_, simdt);
-            return anim_.GetState();
+            vcApplied_ = anim_.GetState();
+            return vcApplied_;
         }
+        bool vc_at_rest() const override { return anim_.GetState() == vcApplied_; }
 
         // IAnimationState
 //        double GetState() const { return state_; }
 
         // panel_animation
         void panel_step(MESHHANDLE mesh, double simdt) override {
-            anim_.Step(state_, simdt);
-            RotateMesh(mesh, pnlGroup_, pnlVerts_, (anim_.GetState() * -angle_));
+            auto angle = anim_.GetState() * -angle_;
+            if (pnlApplied_.changed(angle, _V(0.0, 0.0, 0.0))) {
+                RotateMesh(mesh, pnlGroup_, pnlVerts_, angle);
+            }
         }
 
         int panel_id() override { return panel_id_; }
 
         void set_state(double d) { 
             state_ = d;
+            anim_.SetTarget(d);
         }
 
+        /**
+        Panel rotation changes smaller than this (radians) are not applied.
+        */
+        void set_transform_epsilon(double e) { pnlApplied_.set_epsilon(e); }
+
     private:
         animation_group	vcAnimGroup_;
         double          animSpeed_{ 0.0 };
@@ -94,8 +105,10 @@ namespace bc_orbiter {
         const NTVERTEX* pnlVerts_;
         double          state_{ 0.0 };
         double          angle_{ 0.0 };
-        Tanim           anim_{ animSpeed_ };
+        double          vcApplied_{ -1.0 };     // Last state handed to the VC animation.
+        animation_handle<typename animation_policy<Tanim>::type> anim_{ animSpeed_ };
         int             panel_id_;
+        applied_transform<MESHHANDLE>   pnlApplied_;
     };
 
     using rotary_display_target = rotary_display<animation_target>;
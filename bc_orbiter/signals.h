@@ -16,11 +16,101 @@
 
 #pragma once
 
-#include <functional>
+#include "delegate.h"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
 #include <vector>
 
 namespace bc_orbiter {
 
+	/**
+	* queued_signal
+	* The part of a deferred_signal the signal_queue works with.
+	*/
+	class queued_signal {
+	public:
+		virtual ~queued_signal() = default;
+		virtual void flush_deferred() = 0;
+
+	private:
+		friend class signal_queue;
+
+		int			rank_{ 0 };				// Depth in the connection graph, learned as signals fire each other.
+		unsigned	flushedPass_{ 0 };
+		bool		pending_{ false };
+	};
+
+	/**
+	* signal_queue
+	* Collects deferred signals fired during a frame and notifies their slots in a single pass.
+	* vessel flushes it after mouse events, before the components step and again after.
+	* Signals are flushed in rank order.  A signal fired by a slot while flushing is ranked below
+	* the signal that fired it and is flushed later in the same pass, unless it was already flushed
+	* this pass (a cycle), in which case it waits for the next frame.  Ranks are learned as
+	* signals fire each other, not worked out from the connections beforehand.
+	*/
+	class signal_queue {
+	public:
+		static signal_queue& instance() {
+			static signal_queue queue;
+			return queue;
+		}
+
+		void push(queued_signal* s) {
+			if (s->pending_) return;
+			s->pending_ = true;
+
+			if (flushing_) {
+				s->rank_ = std::max(s->rank_, currentRank_ + 1);
+				if (s->flushedPass_ != pass_) {
+					ready_.push_back(s);
+					return;
+				}
+			}
+
+			pending_.push_back(s);
+		}
+
+		void remove(queued_signal* s) {
+			pending_.erase(std::remove(pending_.begin(), pending_.end(), s), pending_.end());
+			ready_.erase(std::remove(ready_.begin(), ready_.end(), s), ready_.end());
+		}
+
+		void flush() {
+			if (flushing_ || pending_.empty()) return;
+
+			flushing_ = true;
+			pass_++;
+			ready_.swap(pending_);
+
+			while (!ready_.empty()) {
+				auto next = std::min_element(ready_.begin(), ready_.end(),
+					[](queued_signal* a, queued_signal* b) { return a->rank_ < b->rank_; });
+				auto s = *next;
+				*next = ready_.back();
+				ready_.pop_back();
+
+				s->pending_ = false;
+				s->flushedPass_ = pass_;
+				currentRank_ = s->rank_;
+				s->flush_deferred();
+			}
+
+			flushing_ = false;
+		}
+
+	private:
+		signal_queue() = default;
+
+		std::vector<queued_signal*>	pending_;
+		std::vector<queued_signal*>	ready_;
+		unsigned						pass_{ 0 };
+		int								currentRank_{ 0 };
+		bool							flushing_{ false };
+	};
+
 	/**
 	* slot
 	* Receives a notification from a signal when the signal changes.  Used
@@ -29,7 +119,7 @@ namespace bc_orbiter {
 	template<typename T>
 	class slot {
 	public:
-		slot(const std::function<void(T)> func = [](T v) {})
+		slot(const delegate<void(T)> func = [](T v) {})
 			:
 			func_(func)
 		{}
@@ -40,7 +130,7 @@ namespace bc_orbiter {
 			if (dirty_ || (value != value_)) {
 				dirty_ = false;
 				value_ = value;
-				if (nullptr != func_) func_(value_);
+				if (func_) func_(value_);
 			}
 		}
 
@@ -50,18 +140,18 @@ namespace bc_orbiter {
 		bool	dirty_{ true };
 		T		value_	{ };
 		
-		const std::function<void(T)> func_{ nullptr };
+		const delegate<void(T)> func_{ nullptr };
 	};
 
 	/**
 	* signal
-	* Along with slot, provides a means to pass events between components.
+	* Along with slot, provides a means to pass events between components.  Fire notifies the
+	* attached slots right away, see deferred_signal to notify them once per frame.
 	*/
 	template<typename T>
 	class signal {
 	public:
 		signal() = default;
-		virtual ~signal() = default;
 
 		void attach(slot<T>& sl) {
 			slots_.emplace_back(&sl);
@@ -102,6 +192,62 @@ namespace bc_orbiter {
 		T value_{};
 	};
 
+	/**
+	* deferred_signal
+	* A signal whose fire only records the value.  The attached slots are notified once, with the
+	* last value fired, when the signal_queue is next flushed.
+	*/
+	template<typename T>
+	class deferred_signal : public queued_signal {
+	public:
+		deferred_signal() = default;
+		deferred_signal(const deferred_signal&) = delete;
+		deferred_signal& operator=(const deferred_signal&) = delete;
+
+		~deferred_signal() override {
+			signal_queue::instance().remove(this);
+		}
+
+		void attach(slot<T>& sl) {
+			signal_.attach(sl);
+		}
+
+		void fire(const T& val) {
+			signal_.update(val);
+			signal_queue::instance().push(this);
+		}
+
+		void flush_deferred() override {
+			signal_.fire(signal_.current());
+		}
+
+		T current() const {
+			return signal_.current();
+		}
+
+		void update(T val) {	// Update value without firing event (config)
+			signal_.update(val);
+		}
+
+		friend std::istream& operator>>(std::istream& input, deferred_signal<T>& obj) {
+			if (input) {
+				T value;
+				input >> value;
+				obj.fire(value);
+			}
+
+			return input;
+		}
+
+		friend std::ostream& operator<<(std::ostream& output, deferred_signal<T>& obj) {
+			output << obj.current();
+			return output;
+		}
+
+	private:
+		signal<T> signal_;
+	};
+
 	/**
 	* signal
 	* Along with slot, provides a means to pass events between components.
@@ -111,7 +257,7 @@ namespace bc_orbiter {
 		signaller() = default;
 		virtual ~signaller() = default;
 
-		void attach(const std::function<void()> sl) {
+		void attach(const delegate<void()> sl) {
 			funcs_.emplace_back(sl);
 		}
 
@@ -122,7 +268,7 @@ namespace bc_orbiter {
 		}
 
 	private:
-		std::vector<std::function<void()>> funcs_;
+		std::vector<delegate<void()>> funcs_;
 	};
 
 	template<typename TSignal, typename TSlot>
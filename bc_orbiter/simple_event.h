@@ -28,7 +28,7 @@ namespace bc_orbiter {
     * This can be an id or data structure.
     */
     template<typename T = bool>
-    class simple_event :
+    class simple_event final :
         public control,
         public vc_event_target,
         public panel_event_target,
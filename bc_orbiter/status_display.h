@@ -26,7 +26,7 @@ namespace bc_orbiter {
 	status_display
 	A four state status display control intended for the status display panel.
 	**/
-	class status_display :
+	class status_display final :
 		public control
 		, public vc_event_target
 		, public panel_event_target
@@ -56,23 +56,14 @@ namespace bc_orbiter {
 		}
 
 		void on_vc_redraw(DEVMESHHANDLE vcMesh) override {
-			NTVERTEX* delta = new NTVERTEX[4];
-
-			TransformUV2d(
+			TransformUV<DEVMESHHANDLE>(
+				vcMesh,
+				vcGroupId_,
 				vcVerts_,
-				delta, 4,
+				0.0,
 				_V(static_cast<double>(state_) * offset_,
 					0.0,
-					0.0),
-				0.0);
-
-			GROUPEDITSPEC change{};
-			change.flags = GRPEDIT_VTXTEX;
-			change.nVtx = 4;
-			change.vIdx = NULL; //Just use the mesh order
-			change.Vtx = delta;
-			auto res = oapiEditMeshGroup(vcMesh, vcGroupId_, &change);
-			delete[] delta;
+					0.0));
 		}
 
 		void on_panel_redraw(MESHHANDLE meshPanel) override {
@@ -85,8 +76,9 @@ namespace bc_orbiter {
 		int panel_redraw_flags() { return PANEL_REDRAW_USER; }
 
 		void set_state(status s) {
+			auto changed = (s != state_);
 			state_ = s;
-			oapiTriggerRedrawArea(0, 0, get_id());
+			request_redraw_if(changed, redrawStamp_, 0);
 		}
 
 	private:
@@ -96,5 +88,6 @@ namespace bc_orbiter {
 		const NTVERTEX*		pnlVerts_;
 		status				state_{ status::on };
 		double				offset_{ 0.0 };
+		unsigned			redrawStamp_{ 0 };
 	};
 }
@@ -0,0 +1,338 @@
+//	text_renderer - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// No Orbiter dependencies, the surface calls come from the Api parameter of basic_text_renderer
+// (see oapi_surfaces in Tools.h), so the renderer can be run outside Orbiter.
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bc_orbiter {
+
+	enum class text_align { left, right, center };
+
+	/**
+	font_face
+	Bitmap font on a source surface.  Every printable character (32 to 126) has its own x and width
+	so proportional fonts work, all glyphs share one row and height.  Characters without a glyph
+	are skipped.  The blank is a clear area of the source used to erase behind text.
+	*/
+	struct font_face
+	{
+		struct glyph {
+			int		x{ 0 };
+			int		width{ 0 };
+			auto operator<=>(const glyph&) const = default;
+		};
+
+		static constexpr int FIRST = 32;
+		static constexpr int LAST = 126;
+
+		std::array<glyph, LAST - FIRST + 1>	glyphs{};
+		int		y{ 0 };
+		int		height{ 0 };
+		int		blankX{ 0 };
+		int		blankY{ 0 };
+
+		/**
+		fixed
+		Fixed width font with the glyphs in character order starting with ' ' at 'x'.
+		*/
+		static font_face fixed(int x, int y, int charWidth, int height, int blankX, int blankY)
+		{
+			font_face f;
+			for (int i = 0; i < static_cast<int>(f.glyphs.size()); i++) {
+				f.glyphs[i] = { x + (i * charWidth), charWidth };
+			}
+			f.y = y;
+			f.height = height;
+			f.blankX = blankX;
+			f.blankY = blankY;
+			return f;
+		}
+
+		const glyph* find(char c) const
+		{
+			auto i = static_cast<unsigned char>(c);
+			if ((i < FIRST) || (i > LAST) || (glyphs[i - FIRST].width <= 0)) return nullptr;
+			return &glyphs[i - FIRST];
+		}
+
+		auto operator<=>(const font_face&) const = default;
+	};
+
+	/**
+	text_field
+	Area erased with the font blank before the text is drawn, 'left' is relative to the draw
+	position.  A zero width field erases nothing.
+	*/
+	struct text_field {
+		int		left{ 0 };
+		int		width{ 0 };
+		auto operator<=>(const text_field&) const = default;
+	};
+
+	/**
+	text_layout
+	A string as the blits that draw it.  Glyphs that follow each other both on the source and in
+	the string are merged into one run.  Positions are relative to the draw position, 'left' and
+	'width' are the extent of everything drawn.
+	*/
+	struct text_layout
+	{
+		struct run {
+			int		x;			// Target x, relative to the draw position.
+			int		sx;
+			int		sy;
+			int		width;
+		};
+
+		std::vector<run>	runs;
+		int		left{ 0 };
+		int		width{ 0 };
+
+		/**
+		make
+		Lays out 'text' in one pass, glyphs are placed from zero and shifted for the alignment
+		once the width is known.
+		*/
+		static text_layout make(const font_face& face, const char* text, text_align align, text_field field = {})
+		{
+			text_layout l;
+			if (field.width > 0) l.runs.push_back({ field.left, face.blankX, face.blankY, field.width });
+
+			auto first = l.runs.size();
+			int pen = 0;
+			for (auto p = text; *p != '\0'; p++) {
+				auto g = face.find(*p);
+				if (g == nullptr) continue;
+
+				if ((l.runs.size() > first) && (l.runs.back().sx + l.runs.back().width == g->x)) {
+					l.runs.back().width += g->width;
+				}
+				else {
+					l.runs.push_back({ pen, g->x, face.y, g->width });
+				}
+				pen += g->width;
+			}
+
+			auto shift = (align == text_align::center) ? -(pen / 2) : (align == text_align::right) ? -pen : 0;
+			for (auto i = first; i < l.runs.size(); i++) l.runs[i].x += shift;
+
+			auto left = shift;
+			auto right = shift + pen;
+			if (field.width > 0) {
+				left = std::min(left, field.left);
+				right = std::max(right, field.left + field.width);
+			}
+			l.left = left;
+			l.width = right - left;
+			return l;
+		}
+	};
+
+	/**
+	basic_text_renderer
+	Draws strings with a font_face.  Strings drawn more than once are kept in an off screen cache
+	surface, one string per cell, so drawing one again is one blit.  The first time a string is seen
+	it is drawn directly, filling a cell costs a blit more than that and most strings drawn once are
+	never drawn again.  When the cache is full the least recently drawn string gives up its cell.
+	Strings wider than a cell are always drawn directly.
+
+	Api supplies the surface calls:
+		using handle = ...;
+		static void blit(handle target, handle source, int tx, int ty, int sx, int sy, int w, int h);
+		static handle create(int w, int h);		// Null handle if it fails.
+		static void destroy(handle surf);
+	*/
+	template<typename Api>
+	class basic_text_renderer
+	{
+	public:
+		using handle = typename Api::handle;
+
+		basic_text_renderer(int cacheWidth = 512, int cacheHeight = 256, int cellWidth = 128) :
+			  cacheWidth_(cacheWidth)
+			, cacheHeight_(cacheHeight)
+			, cellWidth_(cellWidth)
+		{
+		}
+
+		basic_text_renderer(const basic_text_renderer&) = delete;
+		basic_text_renderer& operator=(const basic_text_renderer&) = delete;
+
+		~basic_text_renderer()
+		{
+			if (cache_ != handle{}) Api::destroy(cache_);
+		}
+
+		/**
+		set_font
+		Font for the following draws, a different font or source empties the cache.
+		*/
+		void set_font(handle source, const font_face& face)
+		{
+			if ((source == source_) && (face == face_)) return;
+
+			source_ = source;
+			face_ = face;
+			clear();
+		}
+
+		/**
+		clear
+		Forgets every string drawn, for when the font source has been reloaded.
+		*/
+		void clear()
+		{
+			index_.clear();
+			used_.clear();
+			seenIndex_.clear();
+			seen_.clear();
+		}
+
+		void draw(handle target, int x, int y, const char* text, text_align align = text_align::left, text_field field = {})
+		{
+			key k{ text, align, field };
+
+			auto it = index_.find(k);
+			if (it != index_.end()) {
+				used_.splice(used_.begin(), used_, it->second);
+				auto& e = *it->second;
+				Api::blit(target, cache_, x + e.left, y, e.cellX, e.cellY, e.width, face_.height);
+				return;
+			}
+
+			auto l = text_layout::make(face_, text, align, field);
+			if (l.runs.empty()) return;
+
+			auto e = ((l.width <= cellWidth_) && seen_before(k)) ? take_cell() : nullptr;
+			if (e == nullptr) {
+				blit_runs(target, x, y, l);
+				return;
+			}
+
+			// Render into the cell with the draw position 'left' from its edge, then copy it out.
+			e->k = std::move(k);
+			e->left = l.left;
+			e->width = l.width;
+			blit_runs(cache_, e->cellX - l.left, e->cellY, l);
+			index_.emplace(e->k, used_.begin());
+			Api::blit(target, cache_, x + l.left, y, e->cellX, e->cellY, l.width, face_.height);
+		}
+
+		size_t cached() const { return used_.size(); }
+
+	private:
+		struct key {
+			std::string		text;
+			text_align		align;
+			text_field		field;
+			auto operator<=>(const key&) const = default;
+		};
+
+		struct entry {
+			key		k;
+			int		cellX;
+			int		cellY;
+			int		left;
+			int		width;
+		};
+
+		void blit_runs(handle target, int x, int y, const text_layout& l)
+		{
+			for (auto& r : l.runs) {
+				Api::blit(target, source_, x + r.x, y, r.sx, r.sy, r.width, face_.height);
+			}
+		}
+
+		size_t capacity() const
+		{
+			auto cols = cacheWidth_ / std::max(1, cellWidth_);
+			auto rows = (face_.height > 0) ? (cacheHeight_ / face_.height) : 0;
+			return static_cast<size_t>(cols * rows);
+		}
+
+		/**
+		seen_before
+		True if 'k' missed the cache recently already, otherwise remembers it.  Only as many misses
+		are remembered as there are cells.
+		*/
+		bool seen_before(const key& k)
+		{
+			auto it = seenIndex_.find(k);
+			if (it != seenIndex_.end()) {
+				seen_.erase(it->second);
+				seenIndex_.erase(it);
+				return true;
+			}
+
+			seen_.push_front(k);
+			seenIndex_.emplace(k, seen_.begin());
+			if (seen_.size() > capacity()) {
+				seenIndex_.erase(seen_.back());
+				seen_.pop_back();
+			}
+			return false;
+		}
+
+		/**
+		take_cell
+		A free cell, or the least recently drawn one, moved to the front of used_.
+		*/
+		entry* take_cell()
+		{
+			auto cols = cacheWidth_ / std::max(1, cellWidth_);
+			auto capacity = this->capacity();
+			if (capacity == 0) return nullptr;
+
+			if (cache_ == handle{}) {
+				cache_ = Api::create(cacheWidth_, cacheHeight_);
+				if (cache_ == handle{}) return nullptr;
+			}
+
+			if (used_.size() < capacity) {
+				auto cell = static_cast<int>(used_.size());
+				used_.push_front({ {}, (cell % cols) * cellWidth_, (cell / cols) * face_.height, 0, 0 });
+			}
+			else {
+				index_.erase(used_.back().k);
+				used_.splice(used_.begin(), used_, std::prev(used_.end()));
+			}
+			return &used_.front();
+		}
+
+		int							cacheWidth_;
+		int							cacheHeight_;
+		int							cellWidth_;
+
+		handle						cache_{};
+		handle						source_{};
+		font_face					face_{};
+
+		std::list<entry>							used_;		// Most recently drawn first.
+		std::map<key, typename std::list<entry>::iterator>	index_;
+		std::list<key>								seen_;		// Recent misses not given a cell, most recent first.
+		std::map<key, typename std::list<key>::iterator>	seenIndex_;
+	};
+}
@@ -16,12 +16,12 @@
 
 #pragma once
 
-#include "control.h"
+#include "Control.h"
 #include "Tools.h"
 
 namespace bc_orbiter {
 
-    class transform_display :
+    class transform_display final :
         public control,
         public vc_tex_animation,
         public panel_animation {
@@ -45,13 +45,17 @@ namespace bc_orbiter {
         // vc_tex_animation
         void vc_step(DEVMESHHANDLE mesh, double simdt) override {
 //            RotateMesh<DEVMESHHANDLE>(mesh, vcGroup_, vcVerts_, angle_);
-            TransformUV<DEVMESHHANDLE>(mesh, vcGroup_, vcVerts_, angle_, vecTrans_);
+            if (vcApplied_.changed(angle_, vecTrans_)) {
+                TransformUV<DEVMESHHANDLE>(mesh, vcGroup_, vcVerts_, angle_, vecTrans_);
+            }
         }
 
         // panel_animation
         void panel_step(MESHHANDLE mesh, double simdt) override {
 //            RotateMesh<MESHHANDLE>(mesh, pnlGroup_, pnlVerts_, angle_);
-            TransformUV<MESHHANDLE>(mesh, pnlGroup_, pnlVerts_, angle_, vecTrans_);
+            if (pnlApplied_.changed(angle_, vecTrans_)) {
+                TransformUV<MESHHANDLE>(mesh, pnlGroup_, pnlVerts_, angle_, vecTrans_);
+            }
         }
 
         int panel_id() override { return pnlId_; }
@@ -59,6 +63,11 @@ namespace bc_orbiter {
         void SetAngle(double a) { angle_ = a; }
         void SetTransform(double x, double y) { vecTrans_.x = x; vecTrans_.y = y; }
 
+        /**
+        Angle and texture offset changes smaller than this are not applied.
+        */
+        void set_transform_epsilon(double e) { vcApplied_.set_epsilon(e); pnlApplied_.set_epsilon(e); }
+
     private:
         double          angle_      { 0.0 };
         VECTOR3         vecTrans_   { 0.0, 0.0, 0.0 };
@@ -67,5 +76,7 @@ namespace bc_orbiter {
         UINT			pnlGroup_   { 0 };
         const NTVERTEX* pnlVerts_;
         int             pnlId_;
+        applied_transform<DEVMESHHANDLE>    vcApplied_;
+        applied_transform<MESHHANDLE>       pnlApplied_;
     };
 }
\ No newline at end of file
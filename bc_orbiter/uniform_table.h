@@ -0,0 +1,81 @@
+//	uniform_table - bco Orbiter Library
+//	Copyright(C) 2023  Blake Christensen
+//
+//	This program is free software : you can redistribute it and / or modify
+//	it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	This program is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+//	GNU General Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License
+//	along with this program.If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace bc_orbiter {
+
+	/**
+	uniform_table
+	N values sampled at even steps of x, looked up with linear interpolation.  The lookup has
+	no search and no branches: x is clamped to the table range and the two samples either side
+	are blended.  Put the breakpoints of a piecewise linear source on the grid and the lookup
+	reproduces it exactly.
+	*/
+	template<size_t N>
+	class uniform_table
+	{
+	public:
+		using sample = std::array<double, N>;
+
+		/**
+		build
+		Samples 'func' from x0 to x1 (inclusive) every 'step'.  'func' is void(double x, sample& out).
+		*/
+		template<typename F>
+		void build(double x0, double x1, double step, F func)
+		{
+			x0_ = x0;
+			invStep_ = 1.0 / step;
+			auto count = static_cast<size_t>(std::lround((x1 - x0) * invStep_)) + 1;
+			last_ = static_cast<double>(count - 1);
+
+			samples_.resize(count + 1);
+			for (size_t i = 0; i < count; i++) {
+				func(x0 + i * step, samples_[i]);
+			}
+			samples_[count] = samples_[count - 1];		// Lets the top of the range read i + 1.
+		}
+
+		bool is_built() const { return !samples_.empty(); }
+
+		sample operator()(double x) const
+		{
+			auto t = std::clamp((x - x0_) * invStep_, 0.0, last_);
+			auto i = static_cast<size_t>(t);
+			auto f = t - i;
+
+			auto& a = samples_[i];
+			auto& b = samples_[i + 1];
+			sample result;
+			for (size_t n = 0; n < N; n++) {
+				result[n] = a[n] + (b[n] - a[n]) * f;
+			}
+			return result;
+		}
+
+	private:
+		std::vector<sample>	samples_;
+		double				x0_{ 0.0 };
+		double				invStep_{ 1.0 };
+		double				last_{ 0.0 };
+	};
+}
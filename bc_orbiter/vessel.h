@@ -17,19 +17,27 @@
 
 #pragma once
 #include "Animation.h"
+#include "animation_store.h"
 #include "Component.h"
 #include "Control.h"
+#include "flight_state.h"
 #include "handler_interfaces.h"
 #include "IAnimationState.h"
+#include "mesh_edit_batch.h"
 #include "Orbitersdk.h"
+#include "profiler.h"
 #include "signals.h"
 
+#include <algorithm>
+#include <cmath>
+#include <concepts>
 #include <vector>
 #include <map>
 #include <memory>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace bc_orbiter
 {
@@ -63,7 +71,7 @@ namespace bc_orbiter
         virtual void clbkVisualCreated(VISHANDLE visHandle, int refCount) override;
         virtual void clbkVisualDestroyed(VISHANDLE vis, int refcount) override;
 
-        virtual ~vessel() {}
+        virtual ~vessel() { profiler_.write_csv(this); }
 
         DEVMESHHANDLE   GetVirtualCockpitMesh0() { return meshVirtualCockpit0_; }
         MESHHANDLE      GetVCMeshHandle0() { return vcMeshHandle0_; }
@@ -79,7 +87,18 @@ namespace bc_orbiter
             return (c == panel_mesh_handles_.end()) ? nullptr : c->second;
         }
 
-        bool            IsStoppedOrDocked();
+        /**
+        Landed and docked state, fetched once per frame at the start of clbkPostStep.  The signals
+        fire when the state changes (and once with the initial state) so components can react to
+        the transition rather than polling.
+        */
+        bool            IsStoppedOrDocked() { refresh_status(); return isLanded_ || isDocked_; }
+        bool            IsLanded() { refresh_status(); return isLanded_; }
+        bool            IsDocked() { refresh_status(); return isDocked_; }
+        bool            HasGroundContact() { refresh_status(); return hasGroundContact_; }
+        signal<bool>&   LandedChangedSignal() { return landedChangedSignal_; }
+        signal<bool>&   DockedChangedSignal() { return dockedChangedSignal_; }
+
         bool            IsCreated() { return isCreated_; }
         void            CreateMainPropellant(double max) { mainPropellant_ = CreatePropellantResource(max); }
         void            CreateRcsPropellant(double max) { rcsPropellant_ = CreatePropellantResource(max); }
@@ -100,6 +119,7 @@ namespace bc_orbiter
             auto animId = VESSEL3::CreateAnimation(0.0);
 
             animations_[animId] = std::make_unique<AT>(target, speed, func);
+            vesselAnimations_.add(animId, animations_[animId].get());
             return animId;
         }
 
@@ -150,37 +170,95 @@ namespace bc_orbiter
         int GetIdForComponent(Component* comp)
         {
             auto id = ++nextEventId_;
-            idComponentMap_[id] = comp;
+            auto& e = event_entry_for(id);
+            e.component = comp;
+            e.set_owner(event_owner::component);
             return id;
         }
 
         int GetControlId() { return ++nextEventId_; }
 
-        void AddControl(control* ctrl) {
+        /**
+        Number of animations stepped, and skipped because they were at rest, during the last clbkPostStep.
+        */
+        int ActiveAnimationCount() const { return activeAnimationCount_; }
+        int SleepingAnimationCount() const { return sleepingAnimationCount_; }
+
+        /**
+        Air data and attitude for the current clbkPostStep.  Each value is taken from Orbiter the
+        first time it is read in the step, so a frame where nothing reads it makes no calls.
+        */
+        const flight_state& GetFlightState() const { return flightState_; }
+
+        /**
+        Redraw requests dropped because the control's visible state had not changed, since the vessel was created.
+        */
+        size_t SuppressedRedrawCount() const { return redraws_.suppressed(); }
+
+        /**
+        VC mesh group edits applied, and replaced by a later edit to the same group before they were applied, since the module loaded.
+        */
+        size_t IssuedMeshEditCount() const { return mesh_edit_batch<DEVMESHHANDLE>::instance().issued(); }
+        size_t MergedMeshEditCount() const { return mesh_edit_batch<DEVMESHHANDLE>::instance().merged(); }
+
+        /**
+        VC and panel mesh edits skipped during the last clbkPostStep because the transform had not changed.
+        */
+        size_t SkippedMeshEditCount() const { return skippedMeshEditCount_; }
+
+        /**
+        Adds a control to the vessel.  An interface the static type 'T' implements is registered
+        directly, without a run time check.  The ones it does not are still looked for with
+        dynamic_cast, so a control passed through a base typed pointer is registered for everything
+        its dynamic type implements.  Pass a final type to skip those checks altogether.
+        */
+        template<std::derived_from<control> T>
+        void AddControl(T* ctrl) {
             if (ctrl->get_id() == -1) ctrl->set_id(GetControlId());
-            controls_.push_back(ctrl);
+            ctrl->set_redraw_queue(&redraws_);
+
+            if (auto c = find_interface<vc_animation>(ctrl))        vc_animation_controls_.push_back(c);
+            if (auto c = find_interface<panel_animation>(ctrl))     panel_animations_.push_back(c);
+            if (auto c = find_interface<vc_tex_animation>(ctrl))    vc_texture_animations_.push_back(c);
+            if (auto c = find_interface<vc_event_target>(ctrl))     add_vc_target(ctrl->get_id(), c);
+            if (auto c = find_interface<panel_event_target>(ctrl))  add_panel_target(ctrl->get_id(), c);
         }
 
-        void AddComponent(vessel_component* c) { components_.push_back(c); }
+        /**
+        Adds a component to the vessel.  Like AddControl, the handler interfaces of the static type
+        are registered directly and the rest are checked for at run time.
+        */
+        template<std::derived_from<vessel_component> T>
+        void AddComponent(T* c) {
+            if (auto p = find_interface<post_step>(c))              add_post_step(p);
+            if (auto p = find_interface<set_class_caps>(c))         set_class_caps_components_.push_back(p);
+            if (auto p = find_interface<draw_hud>(c))               draw_hud_components_.push_back(p);
+            if (auto p = find_interface<load_vc>(c))                load_vc_components_.push_back(p);
+            if (auto p = find_interface<load_panel>(c))             load_panel_components_.push_back(p);
+        }
 
         // Clean this up later when Component goes away
         void RegisterVCComponent(int id, load_vc* vc) {
-            map_vc_component_[id] = vc;
+            auto& e = event_entry_for(id);
+            e.vcHandler = vc;
+            e.set_vc_owner(event_owner::handler);
         }
 
         void RegisterPanelComponent(int id, load_panel* pnl) {
-            map_panel_component_[id] = pnl;
+            auto& e = event_entry_for(id);
+            e.panelHandler = pnl;
+            e.set_panel_owner(event_owner::handler);
         }
 
-        // avionics_provider
-        double get_altitude() const				override { return this->GetAltitude(); }
-        void   get_angular_velocity(VECTOR3& v)	override { this->GetAngularVel(v); }
-        double get_bank() const					override { return this->GetBank(); }
-        double get_heading() const				override { return this->GetYaw(); }
-        double get_keas() const					override { return GetVesselKeas(this); }
-        double get_mach() const					override { return this->GetMachNumber(); }
-        double get_pitch() const				override { return this->GetPitch(); }
-        double get_vertical_speed() const		override { return GetVerticalSpeedFPM(this); }
+        // avionics_provider, served from the flight_state snapshot.
+        double get_altitude() const				override { return flightState_.altitude(); }
+        void   get_angular_velocity(VECTOR3& v)	override { v = flightState_.angular_vel(); }
+        double get_bank() const					override { return flightState_.bank(); }
+        double get_heading() const				override { return flightState_.yaw(); }
+        double get_keas() const					override { return flightState_.keas(); }
+        double get_mach() const					override { return flightState_.mach(); }
+        double get_pitch() const				override { return flightState_.pitch(); }
+        double get_vertical_speed() const		override { return flightState_.vertical_speed_fpm(); }
 
         // propulsion_control
         double get_main_thrust_level() const	override { return this->GetThrusterGroupLevel(THGROUP_MAIN); }
@@ -193,27 +271,186 @@ namespace bc_orbiter
 
     private:
 
-        std::vector<control*>							controls_;
-        std::map<int, vc_event_target*>					map_vc_targets_;
-        std::map<int, panel_event_target*>				map_panel_targets_;
+        /**
+        Which handler kind owns an event id.  Ordered by dispatch priority, a higher
+        value wins when more than one kind registers against the same id.
+        */
+        enum class event_owner : unsigned char { none, handler, target, component };
+
+        /**
+        event_entry
+        One slot in the event dispatch table.  VC and panel events are tagged separately
+        because a control can be both a vc_event_target and a panel_event_target.
+        */
+        struct event_entry
+        {
+            event_owner             vcOwner{ event_owner::none };
+            event_owner             panelOwner{ event_owner::none };
+            Component*              component{ nullptr };
+            vc_event_target*        vcTarget{ nullptr };
+            panel_event_target*     panelTarget{ nullptr };
+            load_vc*                vcHandler{ nullptr };
+            load_panel*             panelHandler{ nullptr };
+
+            void set_vc_owner(event_owner o) { if (o > vcOwner) vcOwner = o; }
+            void set_panel_owner(event_owner o) { if (o > panelOwner) panelOwner = o; }
+            void set_owner(event_owner o) { set_vc_owner(o); set_panel_owner(o); }
+        };
+
+        /**
+        Interface 'I' of 'p', or null.  Known at compile time when 'T' derives from 'I', or when 'T'
+        is final and does not.  Otherwise the dynamic type may add it, so it is checked at run time.
+        BCO_RUNTIME_REGISTRATION checks everything at run time, as before, for Tools/StartupBench
+        to time the full vessel both ways.
+        */
+        template<typename I, typename T>
+        static I* find_interface(T* p)
+        {
+#ifndef BCO_RUNTIME_REGISTRATION
+            if constexpr (std::derived_from<T, I>) return p;
+            else if constexpr (std::is_final_v<T>) return nullptr;
+            else
+#endif
+            return dynamic_cast<I*>(p);
+        }
+
+        void add_post_step(post_step* p) { post_step_components_.push_back({ p, step_period(p->post_step_rate()) }); }
+
+        void add_vc_target(int id, vc_event_target* t)
+        {
+            auto& e = event_entry_for(id);
+            e.vcTarget = t;
+            e.set_vc_owner(event_owner::target);
+        }
+
+        void add_panel_target(int id, panel_event_target* t)
+        {
+            auto& e = event_entry_for(id);
+            e.panelTarget = t;
+            e.set_panel_owner(event_owner::target);
+        }
+
+        /**
+        request_vc_redraws
+        Queues a redraw of every VC target drawn on request.  A reloaded VC shows the mesh defaults
+        until they are redrawn, and a control whose state has not changed since would not ask.
+        */
+        void request_vc_redraws()
+        {
+            for (size_t eid = 0; eid < events_.size(); eid++) {
+                auto vc = events_[eid].vcTarget;
+                if ((nullptr != vc) && (vc->vc_redraw_flags() & PANEL_REDRAW_USER)) redraws_.request(0, (int)eid);
+            }
+        }
+
+        event_entry& event_entry_for(int id)
+        {
+            if (static_cast<size_t>(id) >= events_.size()) events_.resize(id + 1);
+            return events_[id];
+        }
+
+        const event_entry* find_event_entry(int id) const
+        {
+            return ((id < 0) || (static_cast<size_t>(id) >= events_.size())) ? nullptr : &events_[id];
+        }
+
+        /**
+        animation_schedule
+        Splits animations into an active and a sleeping set.  Animations that come to rest are moved
+        to the sleeping set and only checked for a reason to wake up, which avoids a Step and an
+        Orbiter SetAnimation call for every idle switch, door and gauge each frame.
+        */
+        template<typename T>
+        struct animation_schedule
+        {
+            std::vector<std::pair<UINT, T*>>    active;
+            std::vector<std::pair<UINT, T*>>    sleeping;
+
+            void add(UINT id, T* a) { active.emplace_back(id, a); }
+
+            void wake_all()
+            {
+                active.insert(active.end(), sleeping.begin(), sleeping.end());
+                sleeping.clear();
+            }
+
+            template<typename FRest, typename FStep>
+            void step(FRest isAtRest, FStep stepOne, int& activeCount, int& sleepingCount)
+            {
+                for (size_t i = 0; i < sleeping.size(); ) {
+                    if (isAtRest(sleeping[i].second)) { i++; continue; }
+                    active.push_back(sleeping[i]);
+                    sleeping[i] = sleeping.back();
+                    sleeping.pop_back();
+                }
+
+                activeCount += (int)active.size();
+                sleepingCount += (int)sleeping.size();
+
+                for (size_t i = 0; i < active.size(); ) {
+                    stepOne(active[i].first, active[i].second);
+                    if (!isAtRest(active[i].second)) { i++; continue; }
+                    sleeping.push_back(active[i]);
+                    active[i] = active.back();
+                    active.pop_back();
+                }
+            }
+        };
+
+        std::vector<vc_animation*>						vc_animation_controls_;
+        std::vector<event_entry>						events_;				// Indexed by event id.
         std::vector<panel_animation*>					panel_animations_;
         std::vector<vc_tex_animation*>					vc_texture_animations_;
-        std::map<int, vc_animation*>					map_vc_animations_;
+        animation_schedule<vc_animation>				vcAnimations_;
+
+        /**
+        scheduled_step
+        A post_step component and its timing.  period_ is zero for components that run every frame.
+        */
+        struct scheduled_step
+        {
+            post_step*  component_{ nullptr };
+            double      period_{ 0.0 };
+            double      phase_{ 0.0 };
+            double      nextTime_{ 0.0 };
+            double      lastTime_{ 0.0 };
+            bool        started_{ false };
+
+            /** Moves nextTime_ to the first phase_ + k * period_ after 'time'. */
+            void align_after(double time)
+            {
+                nextTime_ = phase_ + (std::floor((time - phase_) / period_) + 1.0) * period_;
+            }
+        };
+
+        static double step_period(step_rate rate)
+        {
+            switch (rate) {
+            case step_rate::hz50:   return 1.0 / 50.0;
+            case step_rate::hz10:   return 1.0 / 10.0;
+            case step_rate::hz1:    return 1.0;
+            default:                return 0.0;
+            }
+        }
 
-        std::vector<vessel_component*>					components_;
-        std::vector<post_step*>							post_step_components_;
+        std::vector<scheduled_step>						post_step_components_;
         std::vector<set_class_caps*>					set_class_caps_components_;
         std::vector<draw_hud*>							draw_hud_components_;
         std::vector<load_vc*>							load_vc_components_;
         std::vector<load_panel*>						load_panel_components_;
-        std::map<int, load_vc*>							map_vc_component_;
-        std::map<int, load_panel*>						map_panel_component_;
-
-        std::map<int, Component*>						idComponentMap_;		// still used by MFDs.  Need to figure that out, then we can get rid of Component
         std::map<UINT, std::unique_ptr<animation>>      animations_;
+        animation_schedule<animation>                   vesselAnimations_;
         std::map<int, MESHHANDLE>                       panel_mesh_handles_;
 
+        profiler            profiler_;      // Empty unless BCO_PROFILE is defined.
         int					nextEventId_{ 0 };
+        flight_state		flightState_{ *this };
+        int					activeAnimationCount_{ 0 };
+        size_t				skippedMeshEditCount_{ 0 };
+        int					sleepingAnimationCount_{ 0 };
+        int					lastCockpitMode_{ -1 };
+        redraw_queue		redraws_;
+        bool				inPostStep_{ false };     // Mesh edits made in clbkPostStep are applied once at its end.
         bool				isCreated_{ false };	// Set true after clbkPostCreation
         VISHANDLE			visualHandle_{ nullptr };
         DEVMESHHANDLE		meshVirtualCockpit0_{ nullptr };
@@ -224,6 +461,15 @@ namespace bc_orbiter
         UINT				vcIndex0_{ 0 };
         UINT                mainIndex_{ 0 };
         VESSELSTATUS2		vesselStatus_;
+        bool				statusValid_{ false };
+        bool				statusKnown_{ false };
+        bool				isLanded_{ false };
+        bool				isDocked_{ false };
+        bool				hasGroundContact_{ false };
+        signal<bool>		landedChangedSignal_;
+        signal<bool>		dockedChangedSignal_;
+
+        void refresh_status();
 
         // Propellent (multiple components need this on setup, so put it in the vessel class)
         PROPELLANT_HANDLE	mainPropellant_{ nullptr };
@@ -241,6 +487,7 @@ namespace bc_orbiter
     inline bool vessel::clbkDrawHUD(int mode, const HUDPAINTSPEC* hps, oapi::Sketchpad* skp)
     {
         for (auto& ps : draw_hud_components_) {
+            profile_scope scope(profiler_, "draw_hud", ps);
             ps->handle_draw_hud(*this, mode, hps, skp);
         }
 
@@ -250,19 +497,27 @@ namespace bc_orbiter
 
     inline bool vessel::clbkLoadVC(int id)
     {
+        redraws_.invalidate();
+        invalidate_mesh_edits();
+
         // Handle controls with load vc requirements.
-        for (auto & vc : map_vc_targets_) {
+        for (size_t eid = 0; eid < events_.size(); eid++) {
+            auto vc = events_[eid].vcTarget;
+            if (nullptr == vc) continue;
+
             oapiVCRegisterArea(
-                vc.first,							// Area ID
-                vc.second->vc_redraw_flags(),		// PANEL_REDRAW_*
-                vc.second->vc_mouse_flags());		// PANEL_MOUSE_*
+                (int)eid,							// Area ID
+                vc->vc_redraw_flags(),				// PANEL_REDRAW_*
+                vc->vc_mouse_flags());				// PANEL_MOUSE_*
 
             oapiVCSetAreaClickmode_Spherical(
-                vc.first,							// Area ID
-                vc.second->vc_event_location(),
-                vc.second->vc_event_radius());
+                (int)eid,							// Area ID
+                vc->vc_event_location(),
+                vc->vc_event_radius());
         }
 
+        request_vc_redraws();
+
         // handle vessel components that require load vc.
         for (auto & vc : load_vc_components_) {
             vc->handle_load_vc(*this, id);
@@ -273,34 +528,30 @@ namespace bc_orbiter
 
     inline void vessel::clbkSetClassCaps(FILEHANDLE cfg)
     {
-        // set_class_caps will flesh out to a more general 'component' list (non-ui/control intities)
-        for (auto & cc : components_) {
-            if (auto* ac = dynamic_cast<post_step*>(cc))        post_step_components_.push_back(ac);
-            if (auto* ac = dynamic_cast<set_class_caps*>(cc))   set_class_caps_components_.push_back(ac);
-            if (auto* ac = dynamic_cast<draw_hud*>(cc))         draw_hud_components_.push_back(ac);
-            if (auto* ac = dynamic_cast<load_vc*>(cc))          load_vc_components_.push_back(ac);
-            if (auto* ac = dynamic_cast<load_panel*>(cc))       load_panel_components_.push_back(ac);
-        }
-
-        // Handle controls that need initialization.
-        for (auto & vc : controls_) {
-            if (auto* c = dynamic_cast<vc_animation*>(vc)) {
-                auto aid = VESSEL3::CreateAnimation(0);
-                auto trans = c->vc_animation_group();
-                trans->transform_->mesh = GetVCMeshIndex();
-                VESSEL3::AddAnimationComponent(
-                    aid,
-                    trans->start_,
-                    trans->stop_,
-                    trans->transform_.get());
-
-                map_vc_animations_[aid] = c;
+        // Stagger the phase of each rate group so slow updates are spread over the period.
+        for (auto rate : { step_rate::hz50, step_rate::hz10, step_rate::hz1 }) {
+            auto period = step_period(rate);
+            auto count = std::count_if(post_step_components_.begin(), post_step_components_.end(),
+                [period](const scheduled_step& s) { return s.period_ == period; });
+
+            int slot = 0;
+            for (auto& ps : post_step_components_) {
+                if (ps.period_ == period) ps.phase_ = period * slot++ / count;
             }
+        }
 
-            if (auto* c = dynamic_cast<panel_animation*>(vc)) panel_animations_.push_back(c);
-            if (auto* c = dynamic_cast<vc_event_target*>(vc)) map_vc_targets_[vc->get_id()] = c;
-            if (auto* c = dynamic_cast<panel_event_target*>(vc)) map_panel_targets_[vc->get_id()] = c;
-            if (auto* c = dynamic_cast<vc_tex_animation*>(vc)) vc_texture_animations_.push_back(c);
+        // VC animations need the VC mesh index, which is not known until now.
+        for (auto & c : vc_animation_controls_) {
+            auto aid = VESSEL3::CreateAnimation(0);
+            auto trans = c->vc_animation_group();
+            trans->transform_->mesh = GetVCMeshIndex();
+            VESSEL3::AddAnimationComponent(
+                aid,
+                trans->start_,
+                trans->stop_,
+                trans->transform_.get());
+
+            vcAnimations_.add(aid, c);
         }
 
         for (auto & sc : set_class_caps_components_) {
@@ -310,16 +561,23 @@ namespace bc_orbiter
 
     inline bool vessel::clbkVCMouseEvent(int id, int event, VECTOR3& p)
     {
-        // Old new mode...
-        auto c = idComponentMap_.find(id);
-        if (c != idComponentMap_.end()) {
-            return c->second->OnVCMouseEvent(id, event);
+        auto e = find_event_entry(id);
+        if (nullptr == e) return false;
+
+        switch (e->vcOwner) {
+        case event_owner::component: {
+            auto handled = e->component->OnVCMouseEvent(id, event);
+            signal_queue::instance().flush();     // Slots see the input before the next step.
+            return handled;
         }
-
-        // NEW mode
-        auto vc = map_vc_targets_.find(id);
-        if (vc != map_vc_targets_.end()) {
-            vc->second->on_event(id, event);
+        case event_owner::target:
+            e->vcTarget->on_event(id, event);
+            signal_queue::instance().flush();
+            redraws_.flush();     // Show the result even when the sim is paused.
+            flush_mesh_edits();
+            break;
+        default:
+            break;
         }
 
         return false;
@@ -329,31 +587,37 @@ namespace bc_orbiter
     {
         if (nullptr == meshVirtualCockpit0_)	return false;
 
-        auto c = idComponentMap_.find(id);
-        if (c != idComponentMap_.end()) {
-            return c->second->OnVCRedrawEvent(id, event, surf);
-        }
+        auto e = find_event_entry(id);
+        if (nullptr == e) return false;
 
-        // NEW mode
-        auto pe = map_vc_targets_.find(id);
-        if (pe != map_vc_targets_.end()) {
-            pe->second->on_vc_redraw(meshVirtualCockpit0_);
+        switch (e->vcOwner) {
+        case event_owner::component: {
+            profile_scope scope(profiler_, "redraw", e->component);
+            return e->component->OnVCRedrawEvent(id, event, surf);
+        }
+        case event_owner::target: {
+            profile_scope scope(profiler_, "redraw", e->vcTarget);
+            e->vcTarget->on_vc_redraw(meshVirtualCockpit0_);
+            if (!inPostStep_) flush_mesh_edits();
             return true;
         }
-
-        auto pc = map_vc_component_.find(id);
-        if (pc != map_vc_component_.end()) {
-            pc->second->handle_redraw_vc(*this, id, event, surf);
+        case event_owner::handler: {
+            profile_scope scope(profiler_, "redraw", e->vcHandler);
+            e->vcHandler->handle_redraw_vc(*this, id, event, surf);
             return true;
         }
-
-        return false;
+        default:
+            return false;
+        }
     }
 
     inline void vessel::clbkVisualCreated(VISHANDLE visHandle, int refCount)
     {
         visualHandle_ = visHandle;
         meshVirtualCockpit0_ = GetDevMesh(visualHandle_, vcIndex0_);
+        redraws_.invalidate();
+        invalidate_mesh_edits();
+        request_vc_redraws();
     }
 
     inline void vessel::clbkVisualDestroyed(VISHANDLE vis, int refcount)
@@ -365,20 +629,43 @@ namespace bc_orbiter
 
     inline void vessel::clbkPostStep(double simt, double simdt, double mjd)
     {
+        inPostStep_ = true;
+        flightState_.reset();
+        statusValid_ = false;
+        refresh_status();
+
+        // Anything fired since the last step (keys, scenario load) reaches its slots before the components read them.
+        signal_queue::instance().flush();
+
+        auto skippedAtStart = skipped_mesh_edits();
+        activeAnimationCount_ = 0;
+        sleepingAnimationCount_ = 0;
+
+        // Controls read their animation state from the shared stores.
+        step_animation_stores(simt, simdt);
+
         // Update animations
-        for (auto& a : animations_)
-        {
-            a.second->Step(simdt);
-            auto state = a.second->GetState();
-            VESSEL3::SetAnimation(a.first, state);
+        vesselAnimations_.step(
+            [](animation* a) { return a->IsAtRest(); },
+            [&](UINT id, animation* a) {
+                a->Step(simdt);
+                VESSEL3::SetAnimation(id, a->GetState());
+            },
+            activeAnimationCount_, sleepingAnimationCount_);
+
+        // VC animations share state with the panel step, so anything asleep may be stale after a mode switch.
+        auto cockpitMode = oapiCockpitMode();
+        if (cockpitMode != lastCockpitMode_) {
+            vcAnimations_.wake_all();
+            lastCockpitMode_ = cockpitMode;
         }
 
         // NEW MODE  << This will go away eventually
-        if (oapiCockpitMode() == COCKPIT_VIRTUAL) {
-            for (auto& va : map_vc_animations_) {
-                auto newState = va.second->vc_step(simdt);
-                VESSEL3::SetAnimation(va.first, newState);
-            }
+        if (cockpitMode == COCKPIT_VIRTUAL) {
+            vcAnimations_.step(
+                [](vc_animation* a) { return a->vc_at_rest(); },
+                [&](UINT id, vc_animation* a) { VESSEL3::SetAnimation(id, a->vc_step(simdt)); },
+                activeAnimationCount_, sleepingAnimationCount_);
 
             auto mesh = GetVirtualCockpitMesh0();
             for (auto& vt : vc_texture_animations_) {
@@ -386,7 +673,7 @@ namespace bc_orbiter
             }
         }
 
-        if (oapiCockpitMode() == COCKPIT_PANELS) {
+        if (cockpitMode == COCKPIT_PANELS) {
             for (auto& pa : panel_animations_) {
                 auto mesh = GetpanelMeshHandle(pa->panel_id());
                 pa->panel_step(mesh, simdt);
@@ -394,8 +681,36 @@ namespace bc_orbiter
         }
 
         for (auto& ps : post_step_components_) {
-            ps->handle_post_step(*this, simt, simdt, mjd);
+            if (ps.period_ == 0.0) {
+                profile_scope scope(profiler_, "post_step", ps.component_);
+                ps.component_->handle_post_step(*this, simt, simdt, mjd);
+                continue;
+            }
+
+            // (Re)start the schedule on the first frame or if sim time jumped backwards.
+            if (!ps.started_ || (simt < ps.lastTime_)) {
+                ps.lastTime_ = simt - simdt;
+                ps.align_after(simt);
+                ps.started_ = true;
+            }
+
+            if (simt < ps.nextTime_) continue;
+
+            profile_scope scope(profiler_, "post_step", ps.component_);
+            ps.component_->handle_post_step(*this, simt, simt - ps.lastTime_, mjd);
+            ps.lastTime_ = simt;
+            ps.nextTime_ += ps.period_;
+            if (ps.nextTime_ <= simt) ps.align_after(simt);   // Fell behind (time warp), skip the missed slots but keep the phase.
         }
+
+        // Deliver deferred signals the components fired this step, then the redraws they and the components requested.
+        signal_queue::instance().flush();
+        redraws_.flush();
+        flush_mesh_edits();
+        inPostStep_ = false;
+        skippedMeshEditCount_ = skipped_mesh_edits() - skippedAtStart;
+
+        profiler_.show();
     }
 
     inline void vessel::clbkPostCreation()
@@ -403,24 +718,49 @@ namespace bc_orbiter
         isCreated_ = true;
     }
 
-    inline bool vessel::IsStoppedOrDocked()
+    inline void vessel::refresh_status()
     {
+        if (statusValid_) return;
+        statusValid_ = true;
+
         vesselStatus_.flag = 0;
         GetStatusEx(&vesselStatus_);
-        return ((vesselStatus_.status == 1) || (DockingStatus(0) == 1));
+        auto landed = (vesselStatus_.status == 1);
+        auto docked = (DockingStatus(0) == 1);
+        hasGroundContact_ = GroundContact();
+
+        auto first = !statusKnown_;
+        statusKnown_ = true;
+
+        if (first || (landed != isLanded_)) {
+            isLanded_ = landed;
+            landedChangedSignal_.fire(landed);
+        }
+
+        if (first || (docked != isDocked_)) {
+            isDocked_ = docked;
+            dockedChangedSignal_.fire(docked);
+        }
     }
 
     inline bool vessel::clbkLoadPanel2D(int id, PANELHANDLE hPanel, DWORD viewW, DWORD viewH)
     {
-        for (auto & p : map_panel_targets_) {	// For panel, mouse and redraw happen in the same call.
-            if (p.second->panel_id() != id) continue;
+        redraws_.invalidate();
+        invalidate_mesh_edits();
+
+        for (size_t eid = 0; eid < events_.size(); eid++) {	// For panel, mouse and redraw happen in the same call.
+            auto p = events_[eid].panelTarget;
+            if ((nullptr == p) || (p->panel_id() != id)) continue;
 
             RegisterPanelArea(
                 hPanel,
-                p.first,                        // Area ID
-                p.second->panel_rect(),
-                p.second->panel_redraw_flags(), // PANEL_REDRAW_*
-                p.second->panel_mouse_flags()); // PANEL_MOUSE_*
+                (int)eid,                       // Area ID
+                p->panel_rect(),
+                p->panel_redraw_flags(),        // PANEL_REDRAW_*
+                p->panel_mouse_flags());        // PANEL_MOUSE_*
+
+            // The new panel shows nothing for this area until it is redrawn, see request_vc_redraws.
+            if (p->panel_redraw_flags() & PANEL_REDRAW_USER) redraws_.request(id, (int)eid);
         }
 
         for (auto & vc : load_panel_components_) {
@@ -432,23 +772,27 @@ namespace bc_orbiter
 
     inline bool vessel::clbkPanelRedrawEvent(int id, int event, SURFHANDLE surf, void* context)
     {
-        // OLD New mode...
-        auto c = idComponentMap_.find(id);
-        if (c != idComponentMap_.end())
-        {
-            return c->second->OnPanelRedrawEvent(id, event, surf);
-        }
+        auto e = find_event_entry(id);
+        if (nullptr == e) return true;
 
-        // NEW mode
-        auto pe = map_panel_targets_.find(id);
-        if (pe != map_panel_targets_.end()) {
-            pe->second->on_panel_redraw(GetpanelMeshHandle(pe->second->panel_id()));
-            return true;
+        switch (e->panelOwner) {
+        case event_owner::component: {
+            profile_scope scope(profiler_, "redraw", e->component);
+            return e->component->OnPanelRedrawEvent(id, event, surf);
         }
-
-        auto pc = map_panel_component_.find(id);
-        if (pc != map_panel_component_.end()) {
-            pc->second->handle_redraw_panel(*this, id, event, surf);
+        case event_owner::target: {
+            profile_scope scope(profiler_, "redraw", e->panelTarget);
+            e->panelTarget->on_panel_redraw(GetpanelMeshHandle(e->panelTarget->panel_id()));
+            if (!inPostStep_) flush_mesh_edits();
+            break;
+        }
+        case event_owner::handler: {
+            profile_scope scope(profiler_, "redraw", e->panelHandler);
+            e->panelHandler->handle_redraw_panel(*this, id, event, surf);
+            break;
+        }
+        default:
+            break;
         }
 
         return true;
@@ -456,17 +800,23 @@ namespace bc_orbiter
 
     inline bool vessel::clbkPanelMouseEvent(int id, int event, int mx, int my)
     {
-        // Old New mode...
-        auto c = idComponentMap_.find(id);
-        if (c != idComponentMap_.end())
-        {
-            return c->second->OnPanelMouseEvent(id, event);
+        auto e = find_event_entry(id);
+        if (nullptr == e) return true;
+
+        switch (e->panelOwner) {
+        case event_owner::component: {
+            auto handled = e->component->OnPanelMouseEvent(id, event);
+            signal_queue::instance().flush();
+            return handled;
         }
-
-        // NEW mode
-        auto pe = map_panel_targets_.find(id);
-        if (pe != map_panel_targets_.end()) {
-            pe->second->on_event(id, event);
+        case event_owner::target:
+            e->panelTarget->on_event(id, event);
+            signal_queue::instance().flush();
+            redraws_.flush();
+            flush_mesh_edits();
+            break;
+        default:
+            break;
         }
 
         return true;